@@ -25,6 +25,11 @@ int AVLTree::getBalanceFactor(AVLNode* node) const {
     return getHeight(node->left) - getHeight(node->right);
 }
 
+void AVLTree::updateNode(AVLNode* node) {
+    node->height = max(getHeight(node->left), getHeight(node->right)) + 1;
+    node->size = getSize(node->left) + getSize(node->right) + 1;
+}
+
 AVLNode* AVLTree::rotateRight(AVLNode* y) {
     AVLNode* x = y->left;
     AVLNode* T2 = x->right;
@@ -33,9 +38,9 @@ AVLNode* AVLTree::rotateRight(AVLNode* y) {
     x->right = y;
     y->left = T2;
     
-    // Update heights
-    y->height = max(getHeight(y->left), getHeight(y->right)) + 1;
-    x->height = max(getHeight(x->left), getHeight(x->right)) + 1;
+    // Update heights and sizes (child first)
+    updateNode(y);
+    updateNode(x);
     
     return x;
 }
@@ -48,9 +53,9 @@ AVLNode* AVLTree::rotateLeft(AVLNode* x) {
     y->left = x;
     x->right = T2;
     
-    // Update heights
-    x->height = max(getHeight(x->left), getHeight(x->right)) + 1;
-    y->height = max(getHeight(y->left), getHeight(y->right)) + 1;
+    // Update heights and sizes (child first)
+    updateNode(x);
+    updateNode(y);
     
     return y;
 }
@@ -58,7 +63,7 @@ AVLNode* AVLTree::rotateLeft(AVLNode* x) {
 AVLNode* AVLTree::insertHelper(AVLNode* node, Aircraft* aircraft, long long timestamp) {
     // Standard BST insert
     if (node == nullptr) {
-        return new AVLNode(aircraft, timestamp);
+        return nodePool.create(aircraft, timestamp);
     }
     
     if (timestamp < node->timestamp) {
@@ -70,31 +75,29 @@ AVLNode* AVLTree::insertHelper(AVLNode* node, Aircraft* aircraft, long long time
         node->right = insertHelper(node->right, aircraft, timestamp);
     }
     
-    // Update height
-    node->height = 1 + max(getHeight(node->left), getHeight(node->right));
+    // Update height and subtree size
+    updateNode(node);
     
     // Get balance factor
     int balance = getBalanceFactor(node);
     
-    // Left Left Case
-    if (balance > 1 && timestamp < node->left->timestamp) {
-        return rotateRight(node);
-    }
-    
-    // Right Right Case
-    if (balance < -1 && timestamp > node->right->timestamp) {
-        return rotateLeft(node);
-    }
-    
-    // Left Right Case
-    if (balance > 1 && timestamp > node->left->timestamp) {
-        node->left = rotateLeft(node->left);
+    // Cases are picked from the child's balance rather than by comparing
+    // timestamps, so runs of equal timestamps still get rebalanced
+    if (balance > 1) {
+        // Left Right Case
+        if (getBalanceFactor(node->left) < 0) {
+            node->left = rotateLeft(node->left);
+        }
+        // Left Left Case
         return rotateRight(node);
     }
     
-    // Right Left Case
-    if (balance < -1 && timestamp < node->right->timestamp) {
-        node->right = rotateRight(node->right);
+    if (balance < -1) {
+        // Right Left Case
+        if (getBalanceFactor(node->right) > 0) {
+            node->right = rotateRight(node->right);
+        }
+        // Right Right Case
         return rotateLeft(node);
     }
     
@@ -110,13 +113,7 @@ bool AVLTree::insert(Aircraft* aircraft, long long timestamp) {
     return true;
 }
 
-void AVLTree::inOrderHelper(AVLNode* node) const {
-    if (node == nullptr) {
-        return;
-    }
-    
-    inOrderHelper(node->left);
-    
+void AVLTree::printEntry(const AVLNode* node) {
     // Print flight log entry
     Aircraft* ac = node->aircraft;
     cout << "Timestamp: " << node->timestamp << "\n";
@@ -127,6 +124,16 @@ void AVLTree::inOrderHelper(AVLNode* node) const {
     cout << "  Status: " << (ac->getIsCrashed() ? "CRASHED" : "LANDED") << "\n";
     cout << "  Final Fuel: " << ac->getFuelLevel() << "%\n";
     cout << "\n";
+}
+
+void AVLTree::inOrderHelper(AVLNode* node) const {
+    if (node == nullptr) {
+        return;
+    }
+    
+    inOrderHelper(node->left);
+    
+    printEntry(node);
     
     inOrderHelper(node->right);
 }
@@ -141,31 +148,125 @@ void AVLTree::printInOrder() const {
     inOrderHelper(root);
 }
 
-void AVLTree::clearHelper(AVLNode* node) {
-    if (node == nullptr) {
-        return;
+void AVLTree::clear() {
+    // Note: We don't delete Aircraft* as it's managed elsewhere
+    nodePool.reset();
+    root = nullptr;
+}
+
+int AVLTree::countBefore(long long timestamp) const {
+    int count = 0;
+    AVLNode* node = root;
+    while (node) {
+        if (node->timestamp < timestamp) {
+            count += getSize(node->left) + 1;
+            node = node->right;
+        } else {
+            node = node->left;
+        }
+    }
+    return count;
+}
+
+int AVLTree::countInRange(long long from, long long to) const {
+    if (from > to) {
+        return 0;
     }
     
-    clearHelper(node->left);
-    clearHelper(node->right);
-    // Note: We don't delete Aircraft* as it's managed elsewhere
-    delete node;
+    // Entries with timestamp <= to, minus those before 'from'
+    int atMost = 0;
+    AVLNode* node = root;
+    while (node) {
+        if (node->timestamp <= to) {
+            atMost += getSize(node->left) + 1;
+            node = node->right;
+        } else {
+            node = node->left;
+        }
+    }
+    return atMost - countBefore(from);
 }
 
-void AVLTree::clear() {
-    clearHelper(root);
-    root = nullptr;
+int AVLTree::countSince(long long timestamp) const {
+    return getLogCount() - countBefore(timestamp);
 }
 
-int AVLTree::getLogCount() const {
-    // Helper function to count nodes
-    struct Counter {
-        static int count(AVLNode* node) {
-            if (node == nullptr) return 0;
-            return 1 + count(node->left) + count(node->right);
+AVLNode* AVLTree::select(int index) const {
+    if (index < 0 || index >= getLogCount()) {
+        return nullptr;
+    }
+    
+    AVLNode* node = root;
+    while (node) {
+        int leftSize = getSize(node->left);
+        if (index < leftSize) {
+            node = node->left;
+        } else if (index == leftSize) {
+            return node;
+        } else {
+            index -= leftSize + 1;
+            node = node->right;
         }
-    };
-    return Counter::count(root);
+    }
+    return nullptr;
+}
+
+AVLNode* AVLTree::getNthMostRecent(int n) const {
+    return select(getLogCount() - n);
+}
+
+AVLTree::RangeIterator::RangeIterator(const AVLTree& tree, long long from, long long to)
+    : top(0), upper(to) {
+    // An AVL path is never longer than the root's height
+    stack = new AVLNode*[tree.getHeight(tree.root) + 1];
+    pushLeft(tree.root, from);
+}
+
+AVLTree::RangeIterator::~RangeIterator() {
+    delete[] stack;
+}
+
+void AVLTree::RangeIterator::pushLeft(AVLNode* node, long long lower) {
+    // Stack the path towards the first timestamp >= lower, skipping
+    // subtrees that lie entirely before it
+    while (node) {
+        if (node->timestamp < lower) {
+            node = node->right;
+        } else {
+            stack[top++] = node;
+            node = node->left;
+        }
+    }
+}
+
+bool AVLTree::RangeIterator::hasNext() const {
+    return top > 0 && stack[top - 1]->timestamp <= upper;
+}
+
+AVLNode* AVLTree::RangeIterator::next() {
+    if (!hasNext()) {
+        return nullptr;
+    }
+    
+    AVLNode* node = stack[--top];
+    
+    // Everything in the right subtree is >= node's timestamp
+    AVLNode* child = node->right;
+    while (child) {
+        stack[top++] = child;
+        child = child->left;
+    }
+    return node;
+}
+
+void AVLTree::printRange(long long from, long long to) const {
+    cout << "\n=== Flight Log (Timestamps " << from << " to " << to << ") ===\n";
+    cout << "Matching entries: " << countInRange(from, to) << "\n\n";
+    
+    RangeIterator it(*this, from, to);
+    while (it.hasNext()) {
+        printEntry(it.next());
+    }
 }
 
 void AVLTree::getAllLogs(Aircraft**& aircraftArray, long long*& timestampArray, int& count) const {
@@ -265,6 +366,7 @@ bool AVLTree::loadFromFile(const char* filename) {
         ac->setLanded(landed == 1);
         ac->setCrashed(crashed == 1);
         ac->setArrivalTimestamp(timestamp);
+        Aircraft::reserveTimestamp(timestamp);
         
         insert(ac, timestamp);
     }
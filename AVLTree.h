@@ -2,6 +2,7 @@
 #define AVLTREE_H
 
 #include "Aircraft.h"
+#include "Pool.h"
 #include <fstream>
 using namespace std;
 
@@ -12,19 +13,23 @@ struct AVLNode {
     AVLNode* left;
     AVLNode* right;
     int height;
+    int size;  // Nodes in this subtree (for rank/select)
     
     AVLNode(Aircraft* ac, long long ts) 
-        : aircraft(ac), timestamp(ts), left(nullptr), right(nullptr), height(1) {}
+        : aircraft(ac), timestamp(ts), left(nullptr), right(nullptr), height(1), size(1) {}
 };
 
 // AVL Tree for maintaining balanced flight log history
 class AVLTree {
 private:
     AVLNode* root;
+    ObjectPool<AVLNode> nodePool;  // All nodes; clear() releases them at once
     
     // Helper functions
     int getHeight(AVLNode* node) const;
     int getBalanceFactor(AVLNode* node) const;
+    int getSize(AVLNode* node) const { return node ? node->size : 0; }
+    void updateNode(AVLNode* node);  // Recompute height and size from children
     int max(int a, int b) const { return (a > b) ? a : b; }
     
     // Rotations
@@ -36,7 +41,7 @@ private:
     
     // Traversal helpers
     void inOrderHelper(AVLNode* node) const;
-    void clearHelper(AVLNode* node);
+    static void printEntry(const AVLNode* node);
     
     // Save/Load helpers (removed - using fstream instead)
     
@@ -56,8 +61,38 @@ public:
     bool saveToFile(const char* filename) const;
     bool loadFromFile(const char* filename);
     
+    // Order statistics (O(log n) via subtree sizes)
+    int countBefore(long long timestamp) const;  // Entries with timestamp < t
+    int countInRange(long long from, long long to) const;  // from <= timestamp <= to
+    int countSince(long long timestamp) const;   // Entries with timestamp >= t
+    AVLNode* select(int index) const;            // index-th entry in time order (0-based)
+    AVLNode* getNthMostRecent(int n) const;      // 1 = latest landing
+    int getHeight() const { return getHeight(root); }
+    const PoolStats& getPoolStats() const { return nodePool.getStats(); }
+    
+    // Iterates entries with from <= timestamp <= to in time order, visiting
+    // only the matching nodes plus one root-to-leaf path
+    class RangeIterator {
+    private:
+        AVLNode** stack;
+        int top;
+        long long upper;
+        
+        void pushLeft(AVLNode* node, long long lower);
+        RangeIterator(const RangeIterator&);
+        RangeIterator& operator=(const RangeIterator&);
+        
+    public:
+        RangeIterator(const AVLTree& tree, long long from, long long to);
+        ~RangeIterator();
+        
+        bool hasNext() const;
+        AVLNode* next();  // nullptr when exhausted
+    };
+    void printRange(long long from, long long to) const;
+    
     // Get all logs for save/load
-    int getLogCount() const;
+    int getLogCount() const { return getSize(root); }  // O(1)
     void getAllLogs(Aircraft**& aircraftArray, long long*& timestampArray, int& count) const;
 };
 
@@ -2,184 +2,147 @@
 #include <cstdlib>
 using namespace std;
 
-Aircraft::Aircraft() : flightID(nullptr), model(nullptr), origin(nullptr), 
-                       destination(nullptr), fuelLevel(100.0), priority(Priority::MEDIUM),
-                       type(AircraftType::COMMERCIAL), currentX(0), currentY(0),
-                       currentNodeID(-1), isLanded(false), isCrashed(false),
-                       arrivalTimestamp(0) {
+long long Aircraft::timestampCounter = 1;
+
+Aircraft::Aircraft() {
+    handle = fleet().allocate(this);
 }
 
 Aircraft::Aircraft(const char* id, const char* mdl, const char* orig, const char* dest,
-                   double fuel, Priority prio, AircraftType tp)
-    : fuelLevel(fuel), priority(prio), type(tp), currentX(0), currentY(0),
-      currentNodeID(-1), isLanded(false), isCrashed(false), arrivalTimestamp(0) {
-    
-    flightID = new char[strlen(id) + 1];
-    strcpy(flightID, id);
-    
-    model = new char[strlen(mdl) + 1];
-    strcpy(model, mdl);
-    
-    origin = new char[strlen(orig) + 1];
-    strcpy(origin, orig);
-    
-    destination = new char[strlen(dest) + 1];
-    strcpy(destination, dest);
+                   double fuel, Priority prio, AircraftType tp) {
+    handle = fleet().allocate(this);
+    FleetStore& store = fleet();
+    store.setFlightID(handle, id);
+    store.setModel(handle, mdl);
+    store.setOrigin(handle, orig);
+    store.setDestination(handle, dest);
+    store.setFuel(handle, fuel);
+    store.setPriority(handle, int(prio));
+    store.setType(handle, int(tp));
+    store.setBurnRate(handle, defaultBurnRate(tp));
 }
 
 Aircraft::Aircraft(const Aircraft& other) {
-    flightID = new char[strlen(other.flightID) + 1];
-    strcpy(flightID, other.flightID);
-    
-    model = new char[strlen(other.model) + 1];
-    strcpy(model, other.model);
-    
-    origin = new char[strlen(other.origin) + 1];
-    strcpy(origin, other.origin);
-    
-    destination = new char[strlen(other.destination) + 1];
-    strcpy(destination, other.destination);
-    
-    fuelLevel = other.fuelLevel;
-    priority = other.priority;
-    type = other.type;
-    currentX = other.currentX;
-    currentY = other.currentY;
-    currentNodeID = other.currentNodeID;
-    isLanded = other.isLanded;
-    isCrashed = other.isCrashed;
-    arrivalTimestamp = other.arrivalTimestamp;
+    handle = fleet().allocate(this);  // A copy is not in any queue
+    *this = other;
 }
 
 Aircraft::~Aircraft() {
-    delete[] flightID;
-    delete[] model;
-    delete[] origin;
-    delete[] destination;
+    fleet().release(handle);
 }
 
 Aircraft& Aircraft::operator=(const Aircraft& other) {
     if (this != &other) {
-        delete[] flightID;
-        delete[] model;
-        delete[] origin;
-        delete[] destination;
-        
-        flightID = new char[strlen(other.flightID) + 1];
-        strcpy(flightID, other.flightID);
+        FleetStore& store = fleet();
+        AircraftHandle from = other.handle;
+        store.setFlightId(handle, store.getFlightId(from));
+        store.setModelID(handle, store.getModelID(from));
+        store.setOriginID(handle, store.getOriginID(from));
+        store.setDestinationID(handle, store.getDestinationID(from));
         
-        model = new char[strlen(other.model) + 1];
-        strcpy(model, other.model);
-        
-        origin = new char[strlen(other.origin) + 1];
-        strcpy(origin, other.origin);
-        
-        destination = new char[strlen(other.destination) + 1];
-        strcpy(destination, other.destination);
-        
-        fuelLevel = other.fuelLevel;
-        priority = other.priority;
-        type = other.type;
-        currentX = other.currentX;
-        currentY = other.currentY;
-        currentNodeID = other.currentNodeID;
-        isLanded = other.isLanded;
-        isCrashed = other.isCrashed;
-        arrivalTimestamp = other.arrivalTimestamp;
+        store.setFuel(handle, store.getFuel(from));
+        store.setPriority(handle, store.getPriority(from));
+        store.setType(handle, store.getType(from));
+        store.setTrack(handle, store.getTrackX(from), store.getTrackY(from));
+        store.setVelocity(handle, store.getVelocityX(from), store.getVelocityY(from));
+        store.setNodeID(handle, store.getNodeID(from));
+        store.setFlag(handle, FleetStore::LANDED, store.hasFlag(from, FleetStore::LANDED));
+        store.setFlag(handle, FleetStore::CRASHED, store.hasFlag(from, FleetStore::CRASHED));
+        store.setArrivalTimestamp(handle, store.getArrivalTimestamp(from));
+        store.setBurnRate(handle, store.getBurnRate(from));
+        // queueIndex is left alone: it tracks this object's own queue slot
     }
     return *this;
 }
 
 void Aircraft::setFlightID(const char* id) {
-    delete[] flightID;
-    flightID = new char[strlen(id) + 1];
-    strcpy(flightID, id);
+    fleet().setFlightID(handle, id);
 }
 
 void Aircraft::setModel(const char* mdl) {
-    delete[] model;
-    model = new char[strlen(mdl) + 1];
-    strcpy(model, mdl);
+    fleet().setModel(handle, mdl);
 }
 
 void Aircraft::setOrigin(const char* orig) {
-    delete[] origin;
-    origin = new char[strlen(orig) + 1];
-    strcpy(origin, orig);
+    fleet().setOrigin(handle, orig);
 }
 
 void Aircraft::setDestination(const char* dest) {
-    delete[] destination;
-    destination = new char[strlen(dest) + 1];
-    strcpy(destination, dest);
+    fleet().setDestination(handle, dest);
 }
 
 void Aircraft::setFuelLevel(double fuel) {
-    fuelLevel = fuel;
+    double fuelLevel = fuel;
     if (fuelLevel < 0) fuelLevel = 0;
     if (fuelLevel > 100) fuelLevel = 100;
+    fleet().setFuel(handle, fuelLevel);
     
     // Auto-update priority if fuel is low
-    if (fuelLevel < 10.0 && priority != Priority::CRITICAL) {
-        priority = Priority::HIGH;
+    if (fuelLevel < 10.0 && getPriority() != Priority::CRITICAL) {
+        setPriority(Priority::HIGH);
     }
 }
 
 void Aircraft::setPriority(Priority prio) {
-    priority = prio;
+    fleet().setPriority(handle, int(prio));
 }
 
 void Aircraft::setType(AircraftType tp) {
-    type = tp;
+    fleet().setType(handle, int(tp));
 }
 
 void Aircraft::setPosition(int x, int y) {
-    currentX = x;
-    currentY = y;
+    fleet().setPosition(handle, x, y);
 }
 
 void Aircraft::setCurrentNodeID(int nodeID) {
-    currentNodeID = nodeID;
+    fleet().setNodeID(handle, nodeID);
 }
 
 void Aircraft::setLanded(bool landed) {
-    isLanded = landed;
+    fleet().setFlag(handle, FleetStore::LANDED, landed);
     if (landed) {
         // Use a simple counter instead of time
-        static long long timestampCounter = 1;
-        arrivalTimestamp = timestampCounter++;
+        fleet().setArrivalTimestamp(handle, timestampCounter++);
     }
 }
 
 void Aircraft::setCrashed(bool crashed) {
-    isCrashed = crashed;
+    fleet().setFlag(handle, FleetStore::CRASHED, crashed);
 }
 
 void Aircraft::setArrivalTimestamp(long long timestamp) {
-    arrivalTimestamp = timestamp;
+    fleet().setArrivalTimestamp(handle, timestamp);
+}
+
+void Aircraft::reserveTimestamp(long long timestamp) {
+    if (timestamp >= timestampCounter) {
+        timestampCounter = timestamp + 1;
+    }
 }
 
 void Aircraft::updateFuel(double delta) {
-    fuelLevel += delta;
+    double fuelLevel = getFuelLevel() + delta;
     if (fuelLevel < 0) fuelLevel = 0;
     if (fuelLevel > 100) fuelLevel = 100;
+    fleet().setFuel(handle, fuelLevel);
     
     // Auto-update priority if fuel is low
-    if (fuelLevel < 10.0 && priority != Priority::CRITICAL) {
-        priority = Priority::HIGH;
+    if (fuelLevel < 10.0 && getPriority() != Priority::CRITICAL) {
+        setPriority(Priority::HIGH);
     }
 }
 
 void Aircraft::declareEmergency() {
-    priority = Priority::CRITICAL;
+    setPriority(Priority::CRITICAL);
 }
 
 bool Aircraft::needsEmergencyLanding() const {
-    return priority == Priority::CRITICAL || fuelLevel < 10.0;
+    return getPriority() == Priority::CRITICAL || getFuelLevel() < 10.0;
 }
 
 const char* Aircraft::getPriorityString() const {
-    switch (priority) {
+    switch (getPriority()) {
         case Priority::CRITICAL: return "CRITICAL";
         case Priority::HIGH: return "HIGH";
         case Priority::MEDIUM: return "MEDIUM";
@@ -188,8 +151,17 @@ const char* Aircraft::getPriorityString() const {
     }
 }
 
+double Aircraft::defaultBurnRate(AircraftType tp) {
+    // Fuel % per time unit: heavy cargo burns fastest, light jets slowest
+    switch (tp) {
+        case AircraftType::CARGO: return 1.2;
+        case AircraftType::PRIVATE: return 0.8;
+        default: return 1.0;
+    }
+}
+
 const char* Aircraft::getTypeString() const {
-    switch (type) {
+    switch (getType()) {
         case AircraftType::COMMERCIAL: return "Commercial";
         case AircraftType::CARGO: return "Cargo";
         case AircraftType::PRIVATE: return "Private";
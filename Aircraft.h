@@ -2,6 +2,7 @@
 #define AIRCRAFT_H
 
 #include <cstring>
+#include "FleetStore.h"
 
 // Aircraft status/priority levels
 enum class Priority {
@@ -19,20 +20,15 @@ enum class AircraftType {
     EMERGENCY
 };
 
+// Aircraft is a view onto one FleetStore slot: all state lives in the
+// shared store's arrays, and the object itself only holds the handle.
+// Constructing an Aircraft allocates the slot, destroying it releases it.
 class Aircraft {
 private:
-    char* flightID;
-    char* model;
-    char* origin;
-    char* destination;
-    double fuelLevel;      // Percentage (0-100)
-    Priority priority;
-    AircraftType type;
-    int currentX, currentY;  // Position on radar grid
-    int currentNodeID;       // Current node in graph
-    bool isLanded;
-    bool isCrashed;
-    long long arrivalTimestamp;  // For AVL tree sorting
+    AircraftHandle handle;
+
+    static long long timestampCounter;  // Next arrival timestamp handed out
+    static FleetStore& fleet() { return FleetStore::shared(); }
 
 public:
     // Constructors
@@ -46,19 +42,26 @@ public:
     Aircraft& operator=(const Aircraft& other);
 
     // Getters
-    const char* getFlightID() const { return flightID; }
-    const char* getModel() const { return model; }
-    const char* getOrigin() const { return origin; }
-    const char* getDestination() const { return destination; }
-    double getFuelLevel() const { return fuelLevel; }
-    Priority getPriority() const { return priority; }
-    AircraftType getType() const { return type; }
-    int getCurrentX() const { return currentX; }
-    int getCurrentY() const { return currentY; }
-    int getCurrentNodeID() const { return currentNodeID; }
-    bool getIsLanded() const { return isLanded; }
-    bool getIsCrashed() const { return isCrashed; }
-    long long getArrivalTimestamp() const { return arrivalTimestamp; }
+    AircraftHandle getHandle() const { return handle; }
+    const char* getFlightID() const { return fleet().getFlightID(handle); }
+    const FlightId& getFlightId() const { return fleet().getFlightId(handle); }
+    const char* getModel() const { return fleet().getModel(handle); }
+    const char* getOrigin() const { return fleet().getOrigin(handle); }
+    const char* getDestination() const { return fleet().getDestination(handle); }
+    int getModelID() const { return fleet().getModelID(handle); }  // Interned: compare IDs, not text
+    int getOriginID() const { return fleet().getOriginID(handle); }
+    int getDestinationID() const { return fleet().getDestinationID(handle); }
+    double getFuelLevel() const { return fleet().getFuel(handle); }
+    Priority getPriority() const { return Priority(fleet().getPriority(handle)); }
+    AircraftType getType() const { return AircraftType(fleet().getType(handle)); }
+    int getCurrentX() const { return fleet().getX(handle); }
+    int getCurrentY() const { return fleet().getY(handle); }
+    int getCurrentNodeID() const { return fleet().getNodeID(handle); }
+    bool getIsLanded() const { return fleet().hasFlag(handle, FleetStore::LANDED); }
+    bool getIsCrashed() const { return fleet().hasFlag(handle, FleetStore::CRASHED); }
+    long long getArrivalTimestamp() const { return fleet().getArrivalTimestamp(handle); }
+    int getQueueIndex() const { return fleet().getQueueIndex(handle); }
+    double getBurnRate() const { return fleet().getBurnRate(handle); }
 
     // Setters
     void setFlightID(const char* id);
@@ -73,6 +76,8 @@ public:
     void setLanded(bool landed);
     void setCrashed(bool crashed);
     void setArrivalTimestamp(long long timestamp);
+    void setBurnRate(double rate) { fleet().setBurnRate(handle, rate); }  // Fuel % per time unit
+    void setQueueIndex(int index) { fleet().setQueueIndex(handle, index); }  // Maintained by the landing queue
 
     // Utility
     void updateFuel(double delta);
@@ -80,6 +85,13 @@ public:
     bool needsEmergencyLanding() const;
     const char* getPriorityString() const;
     const char* getTypeString() const;
+    static double defaultBurnRate(AircraftType tp);
+
+    // Aircraft owning a handle (nullptr if released)
+    static Aircraft* fromHandle(AircraftHandle h) { return fleet().getAircraft(h); }
+
+    // Keep future landings after a timestamp restored from a file
+    static void reserveTimestamp(long long timestamp);
 };
 
 #endif // AIRCRAFT_H
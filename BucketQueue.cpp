@@ -0,0 +1,320 @@
+#include "BucketQueue.h"
+#include "HashTable.h"
+#include "Metrics.h"
+#include <iostream>
+#include <cstring>
+using namespace std;
+
+BucketQueue::BucketQueue(int cap) : fleet(FleetStore::shared()), capacity(cap > 0 ? cap : 1), size(0) {
+    items = new AircraftHandle[capacity];
+    next = new int[capacity];
+    prev = new int[capacity];
+    slotBucket = new int[capacity];
+    
+    // Chain every slot into the free list
+    for (int i = 0; i < capacity; i++) {
+        items[i] = NO_AIRCRAFT;
+        next[i] = (i + 1 < capacity) ? i + 1 : -1;
+        prev[i] = -1;
+        slotBucket[i] = -1;
+    }
+    freeList = capacity > 0 ? 0 : -1;
+    
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        heads[b] = -1;
+        tails[b] = -1;
+        counts[b] = 0;
+    }
+    nonEmpty = 0;
+}
+
+BucketQueue::~BucketQueue() {
+    // Note: We don't delete Aircraft objects here as they're managed elsewhere
+    delete[] items;
+    delete[] next;
+    delete[] prev;
+    delete[] slotBucket;
+}
+
+void BucketQueue::linkTail(int slot, int bucket) {
+    next[slot] = -1;
+    prev[slot] = tails[bucket];
+    if (tails[bucket] != -1) {
+        next[tails[bucket]] = slot;
+    } else {
+        heads[bucket] = slot;
+    }
+    tails[bucket] = slot;
+    slotBucket[slot] = bucket;
+    counts[bucket]++;
+    nonEmpty |= (1u << bucket);
+}
+
+void BucketQueue::unlink(int slot) {
+    int bucket = slotBucket[slot];
+    if (prev[slot] != -1) {
+        next[prev[slot]] = next[slot];
+    } else {
+        heads[bucket] = next[slot];
+    }
+    if (next[slot] != -1) {
+        prev[next[slot]] = prev[slot];
+    } else {
+        tails[bucket] = prev[slot];
+    }
+    
+    counts[bucket]--;
+    if (heads[bucket] == -1) {
+        nonEmpty &= ~(1u << bucket);
+    }
+    slotBucket[slot] = -1;
+    next[slot] = -1;
+    prev[slot] = -1;
+}
+
+void BucketQueue::grow() {
+    int newCapacity = capacity * 2;
+    AircraftHandle* newItems = new AircraftHandle[newCapacity];
+    int* newNext = new int[newCapacity];
+    int* newPrev = new int[newCapacity];
+    int* newSlotBucket = new int[newCapacity];
+    
+    // Slot numbers are kept, so bucket links and queue indices stay valid
+    for (int i = 0; i < capacity; i++) {
+        newItems[i] = items[i];
+        newNext[i] = next[i];
+        newPrev[i] = prev[i];
+        newSlotBucket[i] = slotBucket[i];
+    }
+    
+    // New slots go on the free list ahead of any remaining free slots
+    for (int i = capacity; i < newCapacity; i++) {
+        newItems[i] = NO_AIRCRAFT;
+        newNext[i] = (i + 1 < newCapacity) ? i + 1 : freeList;
+        newPrev[i] = -1;
+        newSlotBucket[i] = -1;
+    }
+    freeList = capacity;
+    
+    delete[] items;
+    delete[] next;
+    delete[] prev;
+    delete[] slotBucket;
+    items = newItems;
+    next = newNext;
+    prev = newPrev;
+    slotBucket = newSlotBucket;
+    capacity = newCapacity;
+}
+
+int BucketQueue::firstBucket() const {
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        if (nonEmpty & (1u << b)) {
+            return b;
+        }
+    }
+    return -1;
+}
+
+bool BucketQueue::insert(Aircraft* aircraft) {
+    OperationTimer timer(Metric::HEAP_INSERT);
+    if (aircraft == nullptr) {
+        return false;
+    }
+    if (aircraft->getQueueIndex() != -1) {
+        return false;  // Already queued
+    }
+    if (!isValidPriority(aircraft->getPriority())) {
+        return false;  // No bucket for it
+    }
+    if (freeList == -1) {
+        grow();
+    }
+    
+    int slot = freeList;
+    freeList = next[slot];
+    
+    items[slot] = aircraft->getHandle();
+    aircraft->setQueueIndex(slot);
+    linkTail(slot, bucketFor(aircraft->getPriority()));
+    size++;
+    
+    return true;
+}
+
+Aircraft* BucketQueue::extractMin() {
+    OperationTimer timer(Metric::HEAP_EXTRACT_MIN);
+    int bucket = firstBucket();
+    if (bucket == -1) {
+        return nullptr;
+    }
+    
+    int slot = heads[bucket];
+    AircraftHandle min = items[slot];
+    unlink(slot);
+    
+    items[slot] = NO_AIRCRAFT;
+    next[slot] = freeList;
+    freeList = slot;
+    size--;
+    
+    fleet.setQueueIndex(min, -1);
+    return fleet.getAircraft(min);
+}
+
+bool BucketQueue::remove(Aircraft* aircraft) {
+    OperationTimer timer(Metric::HEAP_REMOVE);
+    if (!contains(aircraft)) {
+        return false;
+    }
+    
+    int slot = aircraft->getQueueIndex();
+    unlink(slot);
+    
+    items[slot] = NO_AIRCRAFT;
+    next[slot] = freeList;
+    freeList = slot;
+    size--;
+    
+    aircraft->setQueueIndex(-1);
+    return true;
+}
+
+Aircraft* BucketQueue::peek() const {
+    int bucket = firstBucket();
+    if (bucket == -1) {
+        return nullptr;
+    }
+    return fleet.getAircraft(items[heads[bucket]]);
+}
+
+bool BucketQueue::contains(const Aircraft* aircraft) const {
+    if (aircraft == nullptr) {
+        return false;
+    }
+    
+    // Verify the slot so an aircraft queued elsewhere isn't mistaken for ours
+    int slot = aircraft->getQueueIndex();
+    return slot >= 0 && slot < capacity && items[slot] == aircraft->getHandle();
+}
+
+int BucketQueue::findSlot(const char* flightID) const {
+    FlightId id(flightID);
+    if (id.isEmpty()) {
+        return -1;
+    }
+    if (registry != nullptr) {
+        Aircraft* aircraft = registry->search(id);
+        return contains(aircraft) ? aircraft->getQueueIndex() : -1;
+    }
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        for (int slot = heads[b]; slot != -1; slot = next[slot]) {
+            if (fleet.getFlightId(items[slot]) == id) {
+                return slot;
+            }
+        }
+    }
+    return -1;
+}
+
+bool BucketQueue::contains(const char* flightID) const {
+    return findSlot(flightID) != -1;
+}
+
+int BucketQueue::getBucketSize(Priority priority) const {
+    if (!isValidPriority(priority)) {
+        return 0;
+    }
+    return counts[bucketFor(priority)];
+}
+
+bool BucketQueue::decreaseKey(Aircraft* aircraft, Priority newPriority) {
+    if (!contains(aircraft)) {
+        return false;
+    }
+    
+    if (int(newPriority) >= int(aircraft->getPriority())) {
+        return false;  // Not a decrease
+    }
+    
+    return updatePriority(aircraft, newPriority);
+}
+
+bool BucketQueue::updatePriority(Aircraft* aircraft, Priority newPriority) {
+    OperationTimer timer(Metric::HEAP_UPDATE_PRIORITY);
+    if (!contains(aircraft) || !isValidPriority(newPriority)) {
+        return false;
+    }
+    
+    // Compare against the bucket, not the aircraft: its priority may already
+    // have been changed directly (e.g. declareEmergency)
+    aircraft->setPriority(newPriority);
+    int slot = aircraft->getQueueIndex();
+    int bucket = bucketFor(newPriority);
+    if (slotBucket[slot] != bucket) {
+        unlink(slot);
+        linkTail(slot, bucket);
+    }
+    
+    return true;
+}
+
+bool BucketQueue::decreaseKey(const char* flightID, Priority newPriority) {
+    int slot = findSlot(flightID);
+    if (slot == -1) {
+        return false;
+    }
+    return decreaseKey(fleet.getAircraft(items[slot]), newPriority);
+}
+
+bool BucketQueue::updatePriority(const char* flightID, Priority newPriority) {
+    int slot = findSlot(flightID);
+    if (slot == -1) {
+        return false;
+    }
+    return updatePriority(fleet.getAircraft(items[slot]), newPriority);
+}
+
+void BucketQueue::printHeap() const {
+    cout << "\n=== Landing Queue (Priority Buckets) ===\n";
+    if (size == 0) {
+        cout << "Queue is empty.\n";
+        return;
+    }
+    
+    Aircraft* top = peek();
+    cout << "Next to land: " << top->getFlightID()
+         << " (Priority: " << top->getPriorityString() << ")\n";
+    cout << "\nAll aircraft in queue:\n";
+    int position = 1;
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        for (int slot = heads[b]; slot != -1; slot = next[slot]) {
+            Aircraft* ac = fleet.getAircraft(items[slot]);
+            cout << position++ << ". " << ac->getFlightID()
+                 << " - Priority: " << ac->getPriorityString()
+                 << ", Fuel: " << ac->getFuelLevel() << "%\n";
+        }
+    }
+}
+
+void BucketQueue::clear() {
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        for (int slot = heads[b]; slot != -1; slot = next[slot]) {
+            fleet.setQueueIndex(items[slot], -1);
+        }
+        heads[b] = -1;
+        tails[b] = -1;
+        counts[b] = 0;
+    }
+    nonEmpty = 0;
+    size = 0;
+    
+    for (int i = 0; i < capacity; i++) {
+        items[i] = NO_AIRCRAFT;
+        next[i] = (i + 1 < capacity) ? i + 1 : -1;
+        prev[i] = -1;
+        slotBucket[i] = -1;
+    }
+    freeList = capacity > 0 ? 0 : -1;
+}
+
@@ -0,0 +1,71 @@
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include "Aircraft.h"
+#include "LandingQueue.h"
+
+// Landing queue with one FIFO bucket per Priority level.
+// Priority has only four values, so insert, extractMin and priority
+// changes are all O(1). Aircraft of equal priority land in the order they
+// entered their bucket.
+class BucketQueue : public LandingQueue {
+private:
+    static const int BUCKET_COUNT = 4;  // CRITICAL, HIGH, MEDIUM, LOW
+
+    // Slot pool; each bucket is a doubly linked list threaded through it
+    AircraftHandle* items;  // Fleet handle per slot (NO_AIRCRAFT when free)
+    FleetStore& fleet;
+    int* next;
+    int* prev;
+    int* slotBucket;   // Bucket the slot is linked into
+    int freeList;      // Head of unused slots (linked through next)
+    int capacity;
+    int size;
+
+    int heads[BUCKET_COUNT];
+    int tails[BUCKET_COUNT];
+    int counts[BUCKET_COUNT];
+    unsigned int nonEmpty;  // Bit b set when bucket b has aircraft
+
+    // Helper functions
+    static int bucketFor(Priority priority) { return int(priority) - 1; }
+    static bool isValidPriority(Priority priority) {
+        return bucketFor(priority) >= 0 && bucketFor(priority) < BUCKET_COUNT;
+    }
+    void linkTail(int slot, int bucket);
+    void unlink(int slot);
+    int firstBucket() const;
+    int findSlot(const char* flightID) const;
+    void grow();
+
+public:
+    BucketQueue(int cap = 100);  // Initial capacity; grows as aircraft are added
+    ~BucketQueue() override;
+
+    // Core operations
+    bool insert(Aircraft* aircraft) override;
+    Aircraft* extractMin() override;  // Remove and return highest priority aircraft
+    bool remove(Aircraft* aircraft) override;  // O(1) unlink from its bucket
+    bool isEmpty() const override { return size == 0; }
+    int getSize() const override { return size; }
+    int getCapacity() const { return capacity; }
+
+    // Priority update, O(1): move the aircraft to the tail of its new bucket
+    bool decreaseKey(Aircraft* aircraft, Priority newPriority) override;
+    bool updatePriority(Aircraft* aircraft, Priority newPriority) override;
+    bool decreaseKey(const char* flightID, Priority newPriority) override;
+    bool updatePriority(const char* flightID, Priority newPriority) override;
+
+    // Access
+    Aircraft* peek() const override;  // View top without removing
+    bool contains(const Aircraft* aircraft) const override;
+    bool contains(const char* flightID) const override;
+    int getBucketSize(Priority priority) const;
+
+    // Utility
+    void printHeap() const override;
+    void clear() override;
+};
+
+#endif // BUCKETQUEUE_H
+
@@ -0,0 +1,170 @@
+#include "ConflictDetector.h"
+#include <cstring>
+using namespace std;
+
+ConflictDetector::ConflictDetector(float separationMinimum)
+    : fleet(FleetStore::shared()), bucketStart(nullptr), bucketCursor(nullptr), bucketCount(0),
+      gathered(nullptr), gatheredBucket(nullptr), sortedHandle(nullptr), sortedX(nullptr),
+      sortedY(nullptr), sortedCellX(nullptr), sortedCellY(nullptr), entryCapacity(0),
+      entryCount(0), conflictCount(0), conflictCapacity(16), candidateCount(0),
+      conflictFlag(nullptr), flagCapacity(0) {
+    setSeparation(separationMinimum);
+    conflicts = new Conflict[conflictCapacity];
+}
+
+ConflictDetector::~ConflictDetector() {
+    delete[] bucketStart;
+    delete[] bucketCursor;
+    delete[] gathered;
+    delete[] gatheredBucket;
+    delete[] sortedHandle;
+    delete[] sortedX;
+    delete[] sortedY;
+    delete[] sortedCellX;
+    delete[] sortedCellY;
+    delete[] conflicts;
+    delete[] conflictFlag;
+}
+
+void ConflictDetector::setSeparation(float separationMinimum) {
+    separation = separationMinimum > 0.0f ? separationMinimum : 1.0f;
+    cellScale = 1.0f / separation;
+}
+
+void ConflictDetector::rebuild() {
+    int highWater = fleet.getHighWater();
+    
+    // Per-handle scratch is sized to the fleet, not to the airborne count
+    if (entryCapacity < highWater) {
+        delete[] gathered;
+        delete[] gatheredBucket;
+        delete[] sortedHandle;
+        delete[] sortedX;
+        delete[] sortedY;
+        delete[] sortedCellX;
+        delete[] sortedCellY;
+        entryCapacity = fleet.getCapacity();
+        gathered = new AircraftHandle[entryCapacity];
+        gatheredBucket = new int[entryCapacity];
+        sortedHandle = new AircraftHandle[entryCapacity];
+        sortedX = new float[entryCapacity];
+        sortedY = new float[entryCapacity];
+        sortedCellX = new int[entryCapacity];
+        sortedCellY = new int[entryCapacity];
+    }
+    
+    // Airborne aircraft only: active, not landed or crashed, in the airspace
+    entryCount = 0;
+    for (int h = 0; h < highWater; h++) {
+        if (fleet.hasFlag(h, FleetStore::ACTIVE) &&
+            !fleet.hasFlag(h, FleetStore::LANDED | FleetStore::CRASHED) &&
+            fleet.getNodeID(h) != -1) {
+            gathered[entryCount++] = AircraftHandle(h);
+        }
+    }
+    
+    // About two buckets per aircraft keeps unrelated cells apart
+    int wanted = 16;
+    while (wanted < entryCount * 2) {
+        wanted *= 2;
+    }
+    if (wanted != bucketCount) {
+        delete[] bucketStart;
+        delete[] bucketCursor;
+        bucketCount = wanted;
+        bucketStart = new int[bucketCount + 1];
+        bucketCursor = new int[bucketCount];
+    }
+    unsigned int mask = (unsigned int)(bucketCount - 1);
+    
+    // Counting sort by bucket
+    memset(bucketStart, 0, sizeof(int) * (bucketCount + 1));
+    for (int i = 0; i < entryCount; i++) {
+        AircraftHandle h = gathered[i];
+        int bucket = int(cellHash(cellOf(fleet.getTrackX(h)), cellOf(fleet.getTrackY(h))) & mask);
+        gatheredBucket[i] = bucket;
+        bucketStart[bucket + 1]++;
+    }
+    for (int b = 0; b < bucketCount; b++) {
+        bucketStart[b + 1] += bucketStart[b];
+        bucketCursor[b] = bucketStart[b];
+    }
+    for (int i = 0; i < entryCount; i++) {
+        AircraftHandle h = gathered[i];
+        int slot = bucketCursor[gatheredBucket[i]]++;
+        float x = fleet.getTrackX(h);
+        float y = fleet.getTrackY(h);
+        sortedHandle[slot] = h;
+        sortedX[slot] = x;
+        sortedY[slot] = y;
+        sortedCellX[slot] = cellOf(x);
+        sortedCellY[slot] = cellOf(y);
+    }
+}
+
+void ConflictDetector::addConflict(int i, int j, float distance) {
+    if (conflictCount >= conflictCapacity) {
+        int newCapacity = conflictCapacity * 2;
+        Conflict* newConflicts = new Conflict[newCapacity];
+        for (int k = 0; k < conflictCount; k++) {
+            newConflicts[k] = conflicts[k];
+        }
+        delete[] conflicts;
+        conflicts = newConflicts;
+        conflictCapacity = newCapacity;
+    }
+    
+    Conflict& conflict = conflicts[conflictCount++];
+    conflict.first = sortedHandle[i];
+    conflict.second = sortedHandle[j];
+    conflict.distance = distance;
+    conflictFlag[sortedHandle[i]] = 1;
+    conflictFlag[sortedHandle[j]] = 1;
+}
+
+int ConflictDetector::detect() {
+    rebuild();
+    
+    if (flagCapacity < fleet.getCapacity()) {
+        delete[] conflictFlag;
+        flagCapacity = fleet.getCapacity();
+        conflictFlag = new unsigned char[flagCapacity];
+    }
+    memset(conflictFlag, 0, flagCapacity);
+    conflictCount = 0;
+    candidateCount = 0;
+    
+    float limit = separation * separation;
+    unsigned int mask = (unsigned int)(bucketCount - 1);
+    
+    for (int i = 0; i < entryCount; i++) {
+        int cellX = sortedCellX[i];
+        int cellY = sortedCellY[i];
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = cellX + dx;
+                int ny = cellY + dy;
+                int bucket = int(cellHash(nx, ny) & mask);
+                
+                // Each pair is seen from both sides; keep it once (j > i).
+                // A bucket can also hold other cells that hashed with it.
+                int end = bucketStart[bucket + 1];
+                for (int j = bucketStart[bucket]; j < end; j++) {
+                    if (j <= i || sortedCellX[j] != nx || sortedCellY[j] != ny) {
+                        continue;
+                    }
+                    candidateCount++;
+                    float ox = sortedX[j] - sortedX[i];
+                    float oy = sortedY[j] - sortedY[i];
+                    float squared = ox * ox + oy * oy;
+                    if (squared < limit) {
+                        addConflict(i, j, std::sqrt(squared));
+                    }
+                }
+            }
+        }
+    }
+    
+    return conflictCount;
+}
+
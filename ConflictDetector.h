@@ -0,0 +1,79 @@
+#ifndef CONFLICTDETECTOR_H
+#define CONFLICTDETECTOR_H
+
+#include "FleetStore.h"
+
+// Two airborne aircraft closer than the separation minimum
+struct Conflict {
+    AircraftHandle first;
+    AircraftHandle second;
+    float distance;  // Grid units
+};
+
+// Separation check over the whole airborne fleet.
+// Broad phase: a uniform spatial hash with cells one separation minimum
+// wide, rebuilt every pass by counting sort (no per-aircraft allocation).
+// Any pair closer than the minimum lies in the same or an adjacent cell,
+// so each aircraft is only compared with the 3x3 block of cells around
+// it. Narrow phase: exact distance on the candidate pairs. A pass is
+// O(n) for evenly spread traffic instead of O(n^2).
+class ConflictDetector {
+private:
+    FleetStore& fleet;
+    float separation;  // Minimum separation in grid units; also the cell size
+    float cellScale;   // 1 / separation
+    
+    // Cell table. Aircraft are sorted by bucket; bucket b holds
+    // [bucketStart[b], bucketStart[b + 1]) of the sorted arrays.
+    int* bucketStart;
+    int* bucketCursor;
+    int bucketCount;   // Power of two
+    AircraftHandle* gathered;  // Airborne aircraft in handle order
+    int* gatheredBucket;
+    AircraftHandle* sortedHandle;
+    float* sortedX;
+    float* sortedY;
+    int* sortedCellX;
+    int* sortedCellY;
+    int entryCapacity;
+    int entryCount;
+    
+    // Results of the last pass
+    Conflict* conflicts;
+    int conflictCount;
+    int conflictCapacity;
+    int candidateCount;         // Pairs given the exact check
+    unsigned char* conflictFlag;  // Per handle: in at least one conflict
+    int flagCapacity;
+    
+    int cellOf(float coordinate) const { return int(std::floor(coordinate * cellScale)); }
+    static unsigned int cellHash(int cellX, int cellY) {
+        return (unsigned int)cellX * 73856093u ^ (unsigned int)cellY * 19349663u;
+    }
+    void rebuild();
+    void addConflict(int i, int j, float distance);
+    
+    ConflictDetector(const ConflictDetector&);
+    ConflictDetector& operator=(const ConflictDetector&);
+    
+public:
+    ConflictDetector(float separationMinimum = 1.0f);
+    ~ConflictDetector();
+    
+    // Rebuild the cell table from the fleet's tracks and find every pair
+    // of airborne aircraft closer than the separation minimum.
+    int detect();
+    
+    const Conflict* getConflicts() const { return conflicts; }
+    int getConflictCount() const { return conflictCount; }
+    int getCandidateCount() const { return candidateCount; }
+    bool isInConflict(AircraftHandle h) const {
+        return int(h) < flagCapacity && conflictFlag[h] != 0;
+    }
+    
+    void setSeparation(float separationMinimum);
+    float getSeparation() const { return separation; }
+};
+
+#endif // CONFLICTDETECTOR_H
+
@@ -0,0 +1,224 @@
+#include "ConflictPredictor.h"
+#include <cstdlib>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define SKYNET_CPA_SSE 1
+#endif
+
+using namespace std;
+
+// Relative speed below this counts as parallel tracks (closest now)
+static const float MIN_CLOSING_SQUARED = 1e-12f;
+
+static int compareByTime(const void* a, const void* b) {
+    float ta = static_cast<const PredictedConflict*>(a)->timeToClosest;
+    float tb = static_cast<const PredictedConflict*>(b)->timeToClosest;
+    return (ta > tb) - (ta < tb);
+}
+
+ConflictPredictor::ConflictPredictor(float separationMinimum, float horizonMinutes)
+    : fleet(FleetStore::shared()), broadPhase(separationMinimum), relX(nullptr), relY(nullptr),
+      relVX(nullptr), relVY(nullptr), closestTime(nullptr), missSquared(nullptr),
+      pairFirst(nullptr), pairSecond(nullptr), batchCapacity(0), predictionCount(0),
+      predictionCapacity(16), candidateCount(0) {
+    setSeparation(separationMinimum);
+    setHorizon(horizonMinutes);
+    predictions = new PredictedConflict[predictionCapacity];
+}
+
+ConflictPredictor::~ConflictPredictor() {
+    delete[] relX;
+    delete[] relY;
+    delete[] relVX;
+    delete[] relVY;
+    delete[] closestTime;
+    delete[] missSquared;
+    delete[] pairFirst;
+    delete[] pairSecond;
+    delete[] predictions;
+}
+
+void ConflictPredictor::reserveBatch(int count) {
+    if (count <= batchCapacity) {
+        return;
+    }
+    
+    int newCapacity = batchCapacity > 0 ? batchCapacity : 64;
+    while (newCapacity < count) {
+        newCapacity *= 2;
+    }
+    
+    delete[] relX;
+    delete[] relY;
+    delete[] relVX;
+    delete[] relVY;
+    delete[] closestTime;
+    delete[] missSquared;
+    delete[] pairFirst;
+    delete[] pairSecond;
+    relX = new float[newCapacity];
+    relY = new float[newCapacity];
+    relVX = new float[newCapacity];
+    relVY = new float[newCapacity];
+    closestTime = new float[newCapacity];
+    missSquared = new float[newCapacity];
+    pairFirst = new AircraftHandle[newCapacity];
+    pairSecond = new AircraftHandle[newCapacity];
+    batchCapacity = newCapacity;
+}
+
+void ConflictPredictor::closestApproach(int count) {
+    int i = 0;
+
+#ifdef SKYNET_CPA_SSE
+    __m128 vZero = _mm_setzero_ps();
+    __m128 vHorizon = _mm_set1_ps(horizon);
+    __m128 vMinClosing = _mm_set1_ps(MIN_CLOSING_SQUARED);
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(relX + i);
+        __m128 py = _mm_loadu_ps(relY + i);
+        __m128 vx = _mm_loadu_ps(relVX + i);
+        __m128 vy = _mm_loadu_ps(relVY + i);
+        
+        __m128 dot = _mm_add_ps(_mm_mul_ps(px, vx), _mm_mul_ps(py, vy));
+        __m128 speedSq = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy));
+        __m128 closing = _mm_cmpgt_ps(speedSq, vMinClosing);
+        
+        // t = -dot / speedSq, zero for parallel tracks, clamped to the horizon
+        __m128 t = _mm_div_ps(_mm_sub_ps(vZero, dot), _mm_max_ps(speedSq, vMinClosing));
+        t = _mm_and_ps(closing, t);
+        t = _mm_min_ps(_mm_max_ps(t, vZero), vHorizon);
+        
+        __m128 mx = _mm_add_ps(px, _mm_mul_ps(vx, t));
+        __m128 my = _mm_add_ps(py, _mm_mul_ps(vy, t));
+        _mm_storeu_ps(closestTime + i, t);
+        _mm_storeu_ps(missSquared + i, _mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my)));
+    }
+#endif
+
+    // Scalar tail (or whole batch without SSE)
+    for (; i < count; i++) {
+        float speedSq = relVX[i] * relVX[i] + relVY[i] * relVY[i];
+        float t = 0.0f;
+        if (speedSq > MIN_CLOSING_SQUARED) {
+            t = -(relX[i] * relVX[i] + relY[i] * relVY[i]) / speedSq;
+        }
+        if (t < 0.0f) t = 0.0f;
+        if (t > horizon) t = horizon;
+        float mx = relX[i] + relVX[i] * t;
+        float my = relY[i] + relVY[i] * t;
+        closestTime[i] = t;
+        missSquared[i] = mx * mx + my * my;
+    }
+}
+
+void ConflictPredictor::addPrediction(AircraftHandle first, AircraftHandle second,
+                                      float time, float missSq) {
+    if (predictionCount >= predictionCapacity) {
+        int newCapacity = predictionCapacity * 2;
+        PredictedConflict* newPredictions = new PredictedConflict[newCapacity];
+        for (int k = 0; k < predictionCount; k++) {
+            newPredictions[k] = predictions[k];
+        }
+        delete[] predictions;
+        predictions = newPredictions;
+        predictionCapacity = newCapacity;
+    }
+    
+    PredictedConflict& prediction = predictions[predictionCount++];
+    prediction.first = first;
+    prediction.second = second;
+    prediction.timeToClosest = time;
+    prediction.missDistance = std::sqrt(missSq);
+}
+
+int ConflictPredictor::predict() {
+    predictionCount = 0;
+    
+    // Two aircraft can close by at most twice the top fleet speed, so
+    // pairs further apart than this cannot conflict within the horizon
+    const float* vx = fleet.getVelocityXArray();
+    const float* vy = fleet.getVelocityYArray();
+    float topSpeedSq = 0.0f;
+    for (int h = 0; h < fleet.getHighWater(); h++) {
+        float speedSq = vx[h] * vx[h] + vy[h] * vy[h];
+        if (speedSq > topSpeedSq) {
+            topSpeedSq = speedSq;
+        }
+    }
+    broadPhase.setSeparation(separation + 2.0f * std::sqrt(topSpeedSq) * horizon);
+    
+    candidateCount = broadPhase.detect();
+    reserveBatch(candidateCount);
+    
+    // Pack the candidates for the batched kernel
+    const Conflict* pairs = broadPhase.getConflicts();
+    for (int i = 0; i < candidateCount; i++) {
+        AircraftHandle a = pairs[i].first;
+        AircraftHandle b = pairs[i].second;
+        pairFirst[i] = a;
+        pairSecond[i] = b;
+        relX[i] = fleet.getTrackX(b) - fleet.getTrackX(a);
+        relY[i] = fleet.getTrackY(b) - fleet.getTrackY(a);
+        relVX[i] = vx[b] - vx[a];
+        relVY[i] = vy[b] - vy[a];
+    }
+    
+    closestApproach(candidateCount);
+    
+    float limit = separation * separation;
+    for (int i = 0; i < candidateCount; i++) {
+        if (missSquared[i] < limit) {
+            addPrediction(pairFirst[i], pairSecond[i], closestTime[i], missSquared[i]);
+        }
+    }
+    
+    // Most urgent first
+    qsort(predictions, predictionCount, sizeof(PredictedConflict), compareByTime);
+    return predictionCount;
+}
+
+int ConflictPredictor::predictFor(AircraftHandle h, float x, float y, float vx, float vy,
+                                  AircraftHandle& earliest, float& timeToClosest,
+                                  float& missDistance) {
+    earliest = NO_AIRCRAFT;
+    timeToClosest = 0.0f;
+    missDistance = 0.0f;
+    
+    // Every other airborne aircraft, relative to the proposed track
+    reserveBatch(fleet.getHighWater());
+    int count = 0;
+    for (int other = 0; other < fleet.getHighWater(); other++) {
+        if (AircraftHandle(other) == h || !fleet.isActive(other) ||
+            fleet.hasFlag(other, FleetStore::LANDED | FleetStore::CRASHED) ||
+            fleet.getNodeID(other) == -1) {
+            continue;
+        }
+        pairSecond[count] = AircraftHandle(other);
+        relX[count] = fleet.getTrackX(other) - x;
+        relY[count] = fleet.getTrackY(other) - y;
+        relVX[count] = fleet.getVelocityX(other) - vx;
+        relVY[count] = fleet.getVelocityY(other) - vy;
+        count++;
+    }
+    
+    closestApproach(count);
+    
+    float limit = separation * separation;
+    int conflicts = 0;
+    for (int i = 0; i < count; i++) {
+        if (missSquared[i] >= limit) {
+            continue;
+        }
+        if (conflicts == 0 || closestTime[i] < timeToClosest) {
+            earliest = pairSecond[i];
+            timeToClosest = closestTime[i];
+            missDistance = std::sqrt(missSquared[i]);
+        }
+        conflicts++;
+    }
+    return conflicts;
+}
+
@@ -0,0 +1,80 @@
+#ifndef CONFLICTPREDICTOR_H
+#define CONFLICTPREDICTOR_H
+
+#include "FleetStore.h"
+#include "ConflictDetector.h"
+
+// Two aircraft whose current tracks bring them closer than the separation
+// minimum within the look-ahead horizon
+struct PredictedConflict {
+    AircraftHandle first;
+    AircraftHandle second;
+    float timeToClosest;  // Minutes until the closest point of approach
+    float missDistance;   // Separation at that point, grid units
+};
+
+// Closest-point-of-approach (CPA) prediction over a look-ahead window.
+// Each aircraft is extrapolated along its fleet velocity. For a pair with
+// relative position p and relative velocity v, the closest approach is at
+// t = -(p.v) / (v.v), clamped to [0, horizon], with miss distance |p + v t|.
+//
+// Candidate pairs come from a ConflictDetector run with a radius wide
+// enough that no pair outside it can close to the separation minimum
+// within the horizon. Their relative positions and velocities are packed
+// into parallel arrays and the CPA kernel runs over them in one batch
+// (four pairs per step with SSE).
+class ConflictPredictor {
+private:
+    FleetStore& fleet;
+    ConflictDetector broadPhase;
+    float separation;  // Grid units
+    float horizon;     // Minutes
+    
+    // Batched kernel input and output, one entry per candidate pair
+    float* relX;
+    float* relY;
+    float* relVX;
+    float* relVY;
+    float* closestTime;
+    float* missSquared;
+    AircraftHandle* pairFirst;
+    AircraftHandle* pairSecond;
+    int batchCapacity;
+    
+    PredictedConflict* predictions;  // Sorted by timeToClosest
+    int predictionCount;
+    int predictionCapacity;
+    int candidateCount;
+    
+    void reserveBatch(int count);
+    void closestApproach(int count);
+    void addPrediction(AircraftHandle first, AircraftHandle second, float time, float missSq);
+    
+    ConflictPredictor(const ConflictPredictor&);
+    ConflictPredictor& operator=(const ConflictPredictor&);
+    
+public:
+    ConflictPredictor(float separationMinimum = 1.0f, float horizonMinutes = 5.0f);
+    ~ConflictPredictor();
+    
+    // Predict conflicts for every airborne pair. Returns how many.
+    int predict();
+    
+    // Predict for one aircraft placed at (x, y) moving at (vx, vy) against
+    // the rest of the fleet as it is now. Returns how many aircraft it
+    // would conflict with; the earliest is reported through the outputs.
+    int predictFor(AircraftHandle h, float x, float y, float vx, float vy,
+                   AircraftHandle& earliest, float& timeToClosest, float& missDistance);
+    
+    const PredictedConflict* getPredictions() const { return predictions; }
+    int getPredictionCount() const { return predictionCount; }
+    int getCandidateCount() const { return candidateCount; }
+    
+    void setSeparation(float separationMinimum) { separation = separationMinimum > 0.0f ? separationMinimum : 1.0f; }
+    float getSeparation() const { return separation; }
+    void setHorizon(float minutes) { horizon = minutes > 0.0f ? minutes : 0.0f; }
+    float getHorizon() const { return horizon; }
+};
+
+#endif // CONFLICTPREDICTOR_H
+
@@ -0,0 +1,223 @@
+#include "FleetStore.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SKYNET_FLEET_SSE2 1
+#endif
+
+using namespace std;
+
+FleetStore FleetStore::instance;
+
+// Copy the first 'count' entries of an array into a larger one
+template <typename T>
+static void growArray(T*& array, int count, int newCapacity) {
+    T* newArray = new T[newCapacity];
+    for (int i = 0; i < count; i++) {
+        newArray[i] = array[i];
+    }
+    delete[] array;
+    array = newArray;
+}
+
+FleetStore::FleetStore(int cap)
+    : freeCount(0), highWater(0), liveCount(0) {
+    capacity = cap > 0 ? cap : 1;
+    fuel = new double[capacity];
+    priority = new unsigned char[capacity];
+    type = new unsigned char[capacity];
+    flags = new unsigned char[capacity];
+    posX = new int[capacity];
+    posY = new int[capacity];
+    trackX = new float[capacity];
+    trackY = new float[capacity];
+    velocityX = new float[capacity];
+    velocityY = new float[capacity];
+    nodeID = new int[capacity];
+    queueIndex = new int[capacity];
+    arrivalTimestamp = new long long[capacity];
+    burnRate = new double[capacity];
+    activeBurn = new double[capacity];
+    flightID = new FlightId[capacity];
+    modelID = new int[capacity];
+    originID = new int[capacity];
+    destinationID = new int[capacity];
+    owner = new Aircraft*[capacity];
+    freeSlots = new AircraftHandle[capacity];
+    crossedList = new AircraftHandle[capacity];
+}
+
+FleetStore::~FleetStore() {
+    delete[] fuel;
+    delete[] priority;
+    delete[] type;
+    delete[] flags;
+    delete[] posX;
+    delete[] posY;
+    delete[] trackX;
+    delete[] trackY;
+    delete[] velocityX;
+    delete[] velocityY;
+    delete[] nodeID;
+    delete[] queueIndex;
+    delete[] arrivalTimestamp;
+    delete[] burnRate;
+    delete[] activeBurn;
+    delete[] flightID;
+    delete[] modelID;
+    delete[] originID;
+    delete[] destinationID;
+    delete[] owner;
+    delete[] freeSlots;
+    delete[] crossedList;
+}
+
+void FleetStore::grow() {
+    int newCapacity = capacity * 2;
+    growArray(fuel, highWater, newCapacity);
+    growArray(priority, highWater, newCapacity);
+    growArray(type, highWater, newCapacity);
+    growArray(flags, highWater, newCapacity);
+    growArray(posX, highWater, newCapacity);
+    growArray(posY, highWater, newCapacity);
+    growArray(trackX, highWater, newCapacity);
+    growArray(trackY, highWater, newCapacity);
+    growArray(velocityX, highWater, newCapacity);
+    growArray(velocityY, highWater, newCapacity);
+    growArray(nodeID, highWater, newCapacity);
+    growArray(queueIndex, highWater, newCapacity);
+    growArray(arrivalTimestamp, highWater, newCapacity);
+    growArray(burnRate, highWater, newCapacity);
+    growArray(activeBurn, highWater, newCapacity);
+    growArray(flightID, highWater, newCapacity);
+    growArray(modelID, highWater, newCapacity);
+    growArray(originID, highWater, newCapacity);
+    growArray(destinationID, highWater, newCapacity);
+    growArray(owner, highWater, newCapacity);
+    growArray(freeSlots, freeCount, newCapacity);
+    delete[] crossedList;
+    crossedList = new AircraftHandle[newCapacity];
+    capacity = newCapacity;
+}
+
+AircraftHandle FleetStore::allocate(Aircraft* view) {
+    AircraftHandle h;
+    if (freeCount > 0) {
+        h = freeSlots[--freeCount];
+    } else {
+        if (highWater == capacity) {
+            grow();
+        }
+        h = AircraftHandle(highWater++);
+    }
+    
+    fuel[h] = 100.0;
+    priority[h] = 3;  // MEDIUM
+    type[h] = 0;      // COMMERCIAL
+    flags[h] = ACTIVE;
+    posX[h] = 0;
+    posY[h] = 0;
+    trackX[h] = 0.0f;
+    trackY[h] = 0.0f;
+    velocityX[h] = 0.0f;
+    velocityY[h] = 0.0f;
+    nodeID[h] = -1;
+    queueIndex[h] = -1;
+    arrivalTimestamp[h] = 0;
+    burnRate[h] = 1.0;
+    activeBurn[h] = 1.0;
+    flightID[h] = FlightId();
+    modelID[h] = -1;
+    originID[h] = -1;
+    destinationID[h] = -1;
+    owner[h] = view;
+    liveCount++;
+    return h;
+}
+
+void FleetStore::release(AircraftHandle h) {
+    if (h >= AircraftHandle(highWater) || !(flags[h] & ACTIVE)) {
+        return;
+    }
+    
+    owner[h] = nullptr;
+    flags[h] = 0;
+    activeBurn[h] = 0.0;  // Released slots never burn or cross the threshold
+    
+    freeSlots[freeCount++] = h;
+    liveCount--;
+}
+
+int FleetStore::countBelowFuel(double threshold) const {
+    int found = 0;
+    for (int i = 0; i < highWater; i++) {
+        // Branch-free over the flag and fuel arrays
+        found += (flags[i] & (ACTIVE | LANDED | CRASHED)) == ACTIVE && fuel[i] < threshold;
+    }
+    return found;
+}
+
+int FleetStore::findBelowFuel(double threshold, AircraftHandle* out, int maxOut) const {
+    int found = 0;
+    for (int i = 0; i < highWater && found < maxOut; i++) {
+        if ((flags[i] & (ACTIVE | LANDED | CRASHED)) == ACTIVE && fuel[i] < threshold) {
+            out[found++] = AircraftHandle(i);
+        }
+    }
+    return found;
+}
+
+
+int FleetStore::countBoundFor(int destinationTextID) const {
+    int found = 0;
+    for (int i = 0; i < highWater; i++) {
+        found += (flags[i] & (ACTIVE | LANDED | CRASHED)) == ACTIVE && destinationID[i] == destinationTextID;
+    }
+    return found;
+}
+
+
+int FleetStore::burnFuel(double elapsed, double threshold, const AircraftHandle*& crossed) {
+    crossed = crossedList;
+    if (elapsed <= 0.0) {
+        return 0;
+    }
+    
+    int found = 0;
+    int i = 0;
+    
+#ifdef SKYNET_FLEET_SSE2
+    // Two aircraft per step; lanes with activeBurn 0 are left unchanged
+    __m128d vElapsed = _mm_set1_pd(elapsed);
+    __m128d vThreshold = _mm_set1_pd(threshold);
+    __m128d vZero = _mm_setzero_pd();
+    for (; i + 2 <= highWater; i += 2) {
+        __m128d before = _mm_loadu_pd(fuel + i);
+        __m128d rate = _mm_loadu_pd(activeBurn + i);
+        __m128d after = _mm_max_pd(_mm_sub_pd(before, _mm_mul_pd(rate, vElapsed)), vZero);
+        _mm_storeu_pd(fuel + i, after);
+        
+        int mask = _mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(before, vThreshold),
+                                              _mm_cmplt_pd(after, vThreshold)));
+        if (mask != 0) {
+            // Rare: append the crossing lanes to the compact list
+            if (mask & 1) crossedList[found++] = AircraftHandle(i);
+            if (mask & 2) crossedList[found++] = AircraftHandle(i + 1);
+        }
+    }
+#endif
+    
+    // Scalar tail (or whole array without SSE2)
+    for (; i < highWater; i++) {
+        double before = fuel[i];
+        double after = before - activeBurn[i] * elapsed;
+        if (after < 0.0) after = 0.0;
+        fuel[i] = after;
+        crossedList[found] = AircraftHandle(i);
+        found += (before >= threshold) & (after < threshold);
+    }
+    
+    return found;
+}
+
@@ -0,0 +1,183 @@
+#ifndef FLEETSTORE_H
+#define FLEETSTORE_H
+
+#include "StringInterner.h"
+#include "FlightId.h"
+#include <cmath>
+
+class Aircraft;
+
+// Dense 32-bit aircraft handle: index into the FleetStore arrays
+typedef unsigned int AircraftHandle;
+const AircraftHandle NO_AIRCRAFT = 0xFFFFFFFFu;
+
+// Structure-of-arrays store for aircraft state.
+// Hot per-aircraft fields (fuel, priority, position, node, queue slot) sit
+// in parallel contiguous arrays indexed by handle, so whole-fleet passes
+// (fuel burn, low-fuel scans, radar plots) stream through memory. Strings
+// are cold and kept in separate arrays. Aircraft objects are thin views
+// holding a handle; containers store handles and map back with
+// getAircraft() only when they hand an aircraft out.
+//
+// Handles of released aircraft are reused, so containers must drop a
+// handle before its aircraft is deleted.
+class FleetStore {
+public:
+    // Bits of the per-aircraft flags array
+    static const unsigned char ACTIVE = 1;
+    static const unsigned char LANDED = 2;
+    static const unsigned char CRASHED = 4;
+
+private:
+    // Hot state
+    double* fuel;
+    unsigned char* priority;   // Priority value (1 = CRITICAL .. 4 = LOW)
+    unsigned char* type;       // AircraftType value
+    unsigned char* flags;
+    int* posX;                 // Radar cell (trackX/trackY rounded)
+    int* posY;
+    float* trackX;             // Continuous position in grid units
+    float* trackY;
+    float* velocityX;          // Grid units per minute (0 when not moving)
+    float* velocityY;
+    int* nodeID;
+    int* queueIndex;           // Slot in the landing queue (-1 if not queued)
+    long long* arrivalTimestamp;
+    double* burnRate;          // Fuel % burned per time unit while airborne
+    double* activeBurn;        // burnRate while airborne, 0 otherwise (read by burnFuel)
+
+    // Cold state. Flight IDs are stored inline; models and airports come
+    // from a small vocabulary, so they are IDs in StringInterner::shared()
+    // (-1 = not set).
+    FlightId* flightID;
+    int* modelID;
+    int* originID;
+    int* destinationID;
+    Aircraft** owner;          // View object for each handle
+
+    AircraftHandle* freeSlots; // Released handles, reused first
+    int freeCount;
+    int capacity;
+    int highWater;             // Handles in [0, highWater) have been used
+    int liveCount;
+
+    AircraftHandle* crossedList;  // Output of the last burnFuel call
+
+    static FleetStore instance;
+
+    void grow();
+    void refreshBurn(AircraftHandle h) {
+        activeBurn[h] = (flags[h] & (ACTIVE | LANDED | CRASHED)) == ACTIVE ? burnRate[h] : 0.0;
+    }
+    static int internText(const char* text) {
+        return text ? StringInterner::shared().intern(text) : -1;
+    }
+    static const char* textFor(int id) {
+        return id >= 0 ? StringInterner::shared().lookup(id) : nullptr;
+    }
+
+    FleetStore(const FleetStore&);
+    FleetStore& operator=(const FleetStore&);
+
+public:
+    FleetStore(int cap = 128);
+    ~FleetStore();
+
+    // The store every Aircraft lives in
+    static FleetStore& shared() { return instance; }
+
+    AircraftHandle allocate(Aircraft* view);
+    void release(AircraftHandle handle);
+
+    // Whole-fleet iteration: handles in [0, getHighWater()) with isActive()
+    int getHighWater() const { return highWater; }
+    int getLiveCount() const { return liveCount; }
+    int getCapacity() const { return capacity; }
+    bool isActive(AircraftHandle h) const { return (flags[h] & ACTIVE) != 0; }
+    Aircraft* getAircraft(AircraftHandle h) const {
+        return (h < AircraftHandle(highWater) && isActive(h)) ? owner[h] : nullptr;
+    }
+
+    // Hot field access
+    double getFuel(AircraftHandle h) const { return fuel[h]; }
+    void setFuel(AircraftHandle h, double value) { fuel[h] = value; }
+    int getPriority(AircraftHandle h) const { return priority[h]; }
+    void setPriority(AircraftHandle h, int value) { priority[h] = (unsigned char)value; }
+    int getType(AircraftHandle h) const { return type[h]; }
+    void setType(AircraftHandle h, int value) { type[h] = (unsigned char)value; }
+    bool hasFlag(AircraftHandle h, unsigned char flag) const { return (flags[h] & flag) != 0; }
+    void setFlag(AircraftHandle h, unsigned char flag, bool on) {
+        flags[h] = on ? (flags[h] | flag) : (flags[h] & ~flag);
+        refreshBurn(h);
+    }
+    double getBurnRate(AircraftHandle h) const { return burnRate[h]; }
+    void setBurnRate(AircraftHandle h, double rate) {
+        burnRate[h] = rate > 0.0 ? rate : 0.0;
+        refreshBurn(h);
+    }
+    int getX(AircraftHandle h) const { return posX[h]; }
+    int getY(AircraftHandle h) const { return posY[h]; }
+    void setPosition(AircraftHandle h, int x, int y) {
+        posX[h] = x;
+        posY[h] = y;
+        trackX[h] = float(x);
+        trackY[h] = float(y);
+    }
+    float getTrackX(AircraftHandle h) const { return trackX[h]; }
+    float getTrackY(AircraftHandle h) const { return trackY[h]; }
+    void setTrack(AircraftHandle h, float x, float y) {
+        trackX[h] = x;
+        trackY[h] = y;
+        posX[h] = int(std::floor(x + 0.5f));
+        posY[h] = int(std::floor(y + 0.5f));
+    }
+    float getVelocityX(AircraftHandle h) const { return velocityX[h]; }
+    float getVelocityY(AircraftHandle h) const { return velocityY[h]; }
+    void setVelocity(AircraftHandle h, float vx, float vy) { velocityX[h] = vx; velocityY[h] = vy; }
+
+    // Raw track arrays for batched passes over [0, getHighWater())
+    const float* getTrackXArray() const { return trackX; }
+    const float* getTrackYArray() const { return trackY; }
+    const float* getVelocityXArray() const { return velocityX; }
+    const float* getVelocityYArray() const { return velocityY; }
+    int getNodeID(AircraftHandle h) const { return nodeID[h]; }
+    void setNodeID(AircraftHandle h, int value) { nodeID[h] = value; }
+    int getQueueIndex(AircraftHandle h) const { return queueIndex[h]; }
+    void setQueueIndex(AircraftHandle h, int value) { queueIndex[h] = value; }
+    long long getArrivalTimestamp(AircraftHandle h) const { return arrivalTimestamp[h]; }
+    void setArrivalTimestamp(AircraftHandle h, long long value) { arrivalTimestamp[h] = value; }
+
+    // Cold field access
+    const char* getFlightID(AircraftHandle h) const { return flightID[h].c_str(); }
+    const FlightId& getFlightId(AircraftHandle h) const { return flightID[h]; }
+    const char* getModel(AircraftHandle h) const { return textFor(modelID[h]); }
+    const char* getOrigin(AircraftHandle h) const { return textFor(originID[h]); }
+    const char* getDestination(AircraftHandle h) const { return textFor(destinationID[h]); }
+    void setFlightID(AircraftHandle h, const char* text) { flightID[h].assign(text); }
+    void setFlightId(AircraftHandle h, const FlightId& id) { flightID[h] = id; }
+    void setModel(AircraftHandle h, const char* text) { modelID[h] = internText(text); }
+    void setOrigin(AircraftHandle h, const char* text) { originID[h] = internText(text); }
+    void setDestination(AircraftHandle h, const char* text) { destinationID[h] = internText(text); }
+
+    // Interned IDs: equal IDs mean equal text
+    int getModelID(AircraftHandle h) const { return modelID[h]; }
+    int getOriginID(AircraftHandle h) const { return originID[h]; }
+    int getDestinationID(AircraftHandle h) const { return destinationID[h]; }
+    void setModelID(AircraftHandle h, int id) { modelID[h] = id; }
+    void setOriginID(AircraftHandle h, int id) { originID[h] = id; }
+    void setDestinationID(AircraftHandle h, int id) { destinationID[h] = id; }
+
+    // Whole-fleet passes
+    int countBelowFuel(double threshold) const;  // Active, airborne aircraft under threshold
+    int findBelowFuel(double threshold, AircraftHandle* out, int maxOut) const;
+    int countBoundFor(int destinationTextID) const;  // Active, airborne aircraft with that destination
+
+    // Burn fuel for every airborne aircraft over elapsed time units
+    // (fuel -= burnRate * elapsed, floored at 0), vectorized over the fuel
+    // array. Returns how many aircraft dropped from >= threshold to below
+    // it; their handles are in 'crossed', valid until the next call.
+    int burnFuel(double elapsed, double threshold, const AircraftHandle*& crossed);
+};
+
+#endif // FLEETSTORE_H
+
@@ -0,0 +1,46 @@
+#include "FlightId.h"
+#include <iomanip>
+using namespace std;
+
+bool FlightId::assign(const char* id) {
+    memset(text, 0, sizeof(text));
+    hashValue = 0;
+    if (id == nullptr) {
+        return false;
+    }
+    
+    size_t length = strlen(id);
+    if (length == 0 || length > size_t(MAX_LENGTH)) {
+        return false;
+    }
+    memcpy(text, id, length);
+    computeHash();
+    return true;
+}
+
+void FlightId::computeHash() {
+    // The padded text is exactly two 64-bit words: mix them directly
+    unsigned long long words[2];
+    memcpy(words, text, sizeof(words));
+    unsigned long long h = words[0] * 0x9e3779b97f4a7c15ULL;
+    h ^= (words[1] + 0x632be59bd9b4e019ULL) * 0xc2b2ae3d27d4eb4fULL;
+    
+    // Avalanche so IDs differing in one character spread over the table
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    
+    unsigned int result = (unsigned int)(h ^ (h >> 32));
+    hashValue = result != 0 ? result : 1;  // 0 is reserved for the empty ID
+}
+
+istream& operator>>(istream& in, FlightId& id) {
+    char buffer[100];
+    if (in >> setw(sizeof(buffer)) >> buffer) {
+        id.assign(buffer);
+    }
+    return in;
+}
+
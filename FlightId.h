@@ -0,0 +1,59 @@
+#ifndef FLIGHTID_H
+#define FLIGHTID_H
+
+#include <cstring>
+#include <istream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SKYNET_FLIGHTID_SSE2 1
+#endif
+
+// Fixed-width flight identifier: up to 15 characters stored inline and
+// zero-padded to 16 bytes, with the hash computed once on assignment.
+// Equality checks the cached hash, then all 16 bytes in a single 128-bit
+// compare (SSE2) or two 64-bit compares, never byte by byte.
+class FlightId {
+public:
+    static const int MAX_LENGTH = 15;
+
+private:
+    char text[16];          // Zero-padded, always '\0'-terminated
+    unsigned int hashValue; // 0 only for the empty ID
+
+    void computeHash();
+
+public:
+    FlightId() : hashValue(0) { memset(text, 0, sizeof(text)); }
+    explicit FlightId(const char* id) { assign(id); }
+
+    // False (leaving the ID empty) if id is null, empty or too long
+    bool assign(const char* id);
+
+    const char* c_str() const { return text; }
+    bool isEmpty() const { return hashValue == 0; }
+    unsigned int hash() const { return hashValue; }
+
+    bool operator==(const FlightId& other) const {
+        if (hashValue != other.hashValue) {
+            return false;
+        }
+#ifdef SKYNET_FLIGHTID_SSE2
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other.text));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xFFFF;
+#else
+        unsigned long long a[2], b[2];
+        memcpy(a, text, sizeof(a));
+        memcpy(b, other.text, sizeof(b));
+        return ((a[0] ^ b[0]) | (a[1] ^ b[1])) == 0;
+#endif
+    }
+    bool operator!=(const FlightId& other) const { return !(*this == other); }
+};
+
+// Reads one whitespace-delimited token; an over-long token leaves id empty
+std::istream& operator>>(std::istream& in, FlightId& id);
+
+#endif // FLIGHTID_H
+
@@ -0,0 +1,442 @@
+#include "FlightLog.h"
+#include "Metrics.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+using namespace std;
+
+FlightLog::FlightLog()
+    : chunkCount(0), chunkCapacity(4), count(0), strings(StringInterner::shared()),
+      latestKnown(0), latestCapacity(64) {
+    chunks = new LogChunk*[chunkCapacity];
+    chunkStart = new int[chunkCapacity];
+    latestByFlight = new long long[latestCapacity];
+}
+
+FlightLog::~FlightLog() {
+    clear();
+    delete[] chunks;
+    delete[] chunkStart;
+    delete[] latestByFlight;
+}
+
+void FlightLog::growDirectory() {
+    int newCapacity = chunkCapacity * 2;
+    LogChunk** newChunks = new LogChunk*[newCapacity];
+    int* newStart = new int[newCapacity];
+    for (int i = 0; i < chunkCount; i++) {
+        newChunks[i] = chunks[i];
+        newStart[i] = chunkStart[i];
+    }
+    delete[] chunks;
+    delete[] chunkStart;
+    chunks = newChunks;
+    chunkStart = newStart;
+    chunkCapacity = newCapacity;
+}
+
+LogChunk* FlightLog::appendChunk() {
+    if (chunkCount == chunkCapacity) {
+        growDirectory();
+    }
+    LogChunk* chunk = new LogChunk();
+    chunks[chunkCount] = chunk;
+    chunkStart[chunkCount] = count;
+    chunkCount++;
+    return chunk;
+}
+
+void FlightLog::insertChunkAfter(int chunkIndex, LogChunk* chunk) {
+    if (chunkCount == chunkCapacity) {
+        growDirectory();
+    }
+    for (int i = chunkCount; i > chunkIndex + 1; i--) {
+        chunks[i] = chunks[i - 1];
+        chunkStart[i] = chunkStart[i - 1];
+    }
+    chunks[chunkIndex + 1] = chunk;
+    chunkCount++;
+}
+
+void FlightLog::refreshStarts(int fromChunk) {
+    int start = fromChunk > 0 ? chunkStart[fromChunk - 1] + chunks[fromChunk - 1]->count : 0;
+    for (int i = fromChunk; i < chunkCount; i++) {
+        chunkStart[i] = start;
+        start += chunks[i]->count;
+    }
+}
+
+bool FlightLog::insert(const Aircraft* aircraft, long long timestamp) {
+    OperationTimer timer(Metric::LOG_APPEND);
+    if (aircraft == nullptr) {
+        return false;
+    }
+    
+    LogRecord record;
+    record.timestamp = timestamp;
+    record.flightID = strings.intern(aircraft->getFlightID());
+    record.model = aircraft->getModelID();  // Already interned by the fleet
+    record.origin = aircraft->getOriginID();
+    record.destination = aircraft->getDestinationID();
+    record.finalFuel = float(aircraft->getFuelLevel());
+    record.priority = (unsigned char)aircraft->getPriority();
+    record.type = (unsigned char)aircraft->getType();
+    record.status = (aircraft->getIsLanded() ? LOG_LANDED : 0) |
+                    (aircraft->getIsCrashed() ? LOG_CRASHED : 0);
+    return insertRecord(record);
+}
+
+bool FlightLog::insertRecord(const LogRecord& record) {
+    long long timestamp = record.timestamp;
+    
+    // Remember the newest entry per flight for findLatest
+    if (strings.getCount() > latestCapacity) {
+        int newCapacity = latestCapacity * 2;
+        while (newCapacity < strings.getCount()) {
+            newCapacity *= 2;
+        }
+        long long* newLatest = new long long[newCapacity];
+        for (int i = 0; i < latestCapacity; i++) {
+            newLatest[i] = latestByFlight[i];
+        }
+        delete[] latestByFlight;
+        latestByFlight = newLatest;
+        latestCapacity = newCapacity;
+    }
+    if (record.flightID >= latestKnown) {
+        for (int i = latestKnown; i <= record.flightID; i++) {
+            latestByFlight[i] = -1;
+        }
+        latestKnown = record.flightID + 1;
+    }
+    if (timestamp > latestByFlight[record.flightID]) {
+        latestByFlight[record.flightID] = timestamp;
+    }
+    
+    // Fast path: timestamp is not older than the newest record
+    LogChunk* last = chunkCount > 0 ? chunks[chunkCount - 1] : nullptr;
+    if (last == nullptr || last->entries[last->count - 1].timestamp <= timestamp) {
+        if (last == nullptr || last->count == LogChunk::CAPACITY) {
+            last = appendChunk();
+        }
+        last->entries[last->count] = record;
+        last->count++;
+        count++;
+        return true;
+    }
+    
+    // Out of order: equal timestamps go after existing ones, like AVLTree
+    int index = locate(timestamp, true);
+    
+    // Find the chunk holding position 'index' (the last chunk for the end)
+    int lo = 0;
+    int hi = chunkCount - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (chunkStart[mid] <= index) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    int c = lo;
+    int position = index - chunkStart[c];
+    
+    LogChunk* chunk = chunks[c];
+    if (chunk->count == LogChunk::CAPACITY) {
+        // Split: move the upper half into a new chunk after this one
+        LogChunk* upperHalf = new LogChunk();
+        int half = LogChunk::CAPACITY / 2;
+        for (int i = half; i < chunk->count; i++) {
+            upperHalf->entries[i - half] = chunk->entries[i];
+        }
+        upperHalf->count = chunk->count - half;
+        chunk->count = half;
+        insertChunkAfter(c, upperHalf);
+        chunkStart[c + 1] = chunkStart[c] + half;
+        
+        if (position > half) {
+            c++;
+            chunk = upperHalf;
+            position -= half;
+        }
+    }
+    
+    for (int i = chunk->count; i > position; i--) {
+        chunk->entries[i] = chunk->entries[i - 1];
+    }
+    chunk->entries[position] = record;
+    chunk->count++;
+    count++;
+    
+    refreshStarts(c + 1);
+    return true;
+}
+
+int FlightLog::locate(long long timestamp, bool afterEqual) const {
+    // First chunk whose last record is past the timestamp
+    int lo = 0;
+    int hi = chunkCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        const LogChunk* chunk = chunks[mid];
+        long long lastTs = chunk->entries[chunk->count - 1].timestamp;
+        bool past = afterEqual ? lastTs > timestamp : lastTs >= timestamp;
+        if (past) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    if (lo == chunkCount) {
+        return count;
+    }
+    
+    // Then the first record inside it
+    const LogChunk* chunk = chunks[lo];
+    int left = 0;
+    int right = chunk->count;
+    while (left < right) {
+        int mid = (left + right) / 2;
+        long long ts = chunk->entries[mid].timestamp;
+        bool past = afterEqual ? ts > timestamp : ts >= timestamp;
+        if (past) {
+            right = mid;
+        } else {
+            left = mid + 1;
+        }
+    }
+    return chunkStart[lo] + left;
+}
+
+int FlightLog::countBefore(long long timestamp) const {
+    return locate(timestamp, false);
+}
+
+int FlightLog::countInRange(long long from, long long to) const {
+    OperationTimer timer(Metric::LOG_RANGE);
+    if (from > to) {
+        return 0;
+    }
+    return locate(to, true) - locate(from, false);
+}
+
+int FlightLog::countSince(long long timestamp) const {
+    return count - locate(timestamp, false);
+}
+
+const LogRecord* FlightLog::select(int index) const {
+    if (index < 0 || index >= count) {
+        return nullptr;
+    }
+    
+    // Last chunk starting at or before index
+    int lo = 0;
+    int hi = chunkCount - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (chunkStart[mid] <= index) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return &chunks[lo]->entries[index - chunkStart[lo]];
+}
+
+const LogRecord* FlightLog::getNthMostRecent(int n) const {
+    return select(count - n);
+}
+
+FlightLog::RangeIterator::RangeIterator(const FlightLog& flightLog, long long from, long long to)
+    : log(flightLog), chunk(0), position(0), upper(to) {
+    int index = flightLog.locate(from, false);
+    if (index >= flightLog.count) {
+        chunk = flightLog.chunkCount;  // Nothing at or after 'from'
+        return;
+    }
+    
+    // Convert the global index to chunk/position
+    while (chunk + 1 < flightLog.chunkCount && flightLog.chunkStart[chunk + 1] <= index) {
+        chunk++;
+    }
+    position = index - flightLog.chunkStart[chunk];
+}
+
+bool FlightLog::RangeIterator::hasNext() const {
+    return chunk < log.chunkCount &&
+           log.chunks[chunk]->entries[position].timestamp <= upper;
+}
+
+const LogRecord* FlightLog::RangeIterator::next() {
+    if (!hasNext()) {
+        return nullptr;
+    }
+    
+    const LogRecord* entry = &log.chunks[chunk]->entries[position];
+    position++;
+    if (position == log.chunks[chunk]->count) {
+        chunk++;
+        position = 0;
+    }
+    return entry;
+}
+
+const LogRecord* FlightLog::findLatest(const char* flightID) const {
+    int id = strings.find(flightID);
+    if (id == -1 || id >= latestKnown || latestByFlight[id] == -1) {
+        return nullptr;
+    }
+    
+    // Scan the records sharing that timestamp for the flight
+    RangeIterator it(*this, latestByFlight[id], latestByFlight[id]);
+    while (it.hasNext()) {
+        const LogRecord* entry = it.next();
+        if (entry->flightID == id) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+void FlightLog::printEntry(const LogRecord* entry) const {
+    // Print flight log entry
+    cout << "Timestamp: " << entry->timestamp << "\n";
+    cout << "  Flight ID: " << strings.lookup(entry->flightID) << "\n";
+    cout << "  Model: " << strings.lookup(entry->model) << "\n";
+    cout << "  Origin: " << strings.lookup(entry->origin) << "\n";
+    cout << "  Destination: " << strings.lookup(entry->destination) << "\n";
+    cout << "  Status: " << ((entry->status & LOG_CRASHED) ? "CRASHED" : "LANDED") << "\n";
+    cout << "  Final Fuel: " << entry->finalFuel << "%\n";
+    cout << "\n";
+}
+
+void FlightLog::printInOrder() const {
+    cout << "\n=== Flight Log History (Chronological) ===\n";
+    if (count == 0) {
+        cout << "No flight logs available.\n";
+        return;
+    }
+    
+    for (int c = 0; c < chunkCount; c++) {
+        for (int i = 0; i < chunks[c]->count; i++) {
+            printEntry(&chunks[c]->entries[i]);
+        }
+    }
+}
+
+void FlightLog::printRange(long long from, long long to) const {
+    cout << "\n=== Flight Log (Timestamps " << from << " to " << to << ") ===\n";
+    cout << "Matching entries: " << countInRange(from, to) << "\n\n";
+    
+    RangeIterator it(*this, from, to);
+    while (it.hasNext()) {
+        printEntry(it.next());
+    }
+}
+
+void FlightLog::clear() {
+    for (int c = 0; c < chunkCount; c++) {
+        delete chunks[c];
+    }
+    chunkCount = 0;
+    count = 0;
+    latestKnown = 0;  // Shared strings stay; other logs and the fleet use them
+}
+
+bool FlightLog::saveToFile(const char* filename) const {
+    OperationTimer timer(Metric::LOG_SAVE);
+    ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    file << count << "\n";
+    
+    for (int c = 0; c < chunkCount; c++) {
+        for (int i = 0; i < chunks[c]->count; i++) {
+            const LogRecord& entry = chunks[c]->entries[i];
+            file << strings.lookup(entry.flightID) << "|"
+                 << strings.lookup(entry.model) << "|"
+                 << strings.lookup(entry.origin) << "|"
+                 << strings.lookup(entry.destination) << "|"
+                 << entry.finalFuel << "|"
+                 << int(entry.priority) << "|"
+                 << int(entry.type) << "|"
+                 << entry.timestamp << "|"
+                 << ((entry.status & LOG_LANDED) ? 1 : 0) << "|"
+                 << ((entry.status & LOG_CRASHED) ? 1 : 0) << "\n";
+        }
+    }
+    
+    file.close();
+    return true;
+}
+
+bool FlightLog::loadFromFile(const char* filename, int* skipped) {
+    OperationTimer timer(Metric::LOG_LOAD);
+    ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    clear();
+    
+    int logCount;
+    file >> logCount;
+    file.ignore();  // Skip newline
+    
+    char flightID[100], model[100], origin[100], destination[100];
+    double fuel;
+    int priority, type, landed, crashed;
+    long long timestamp;
+    char delimiter;
+    int rejected = 0;
+    
+    for (int i = 0; i < logCount; i++) {
+        file.getline(flightID, 100, '|');
+        file.getline(model, 100, '|');
+        file.getline(origin, 100, '|');
+        file.getline(destination, 100, '|');
+        file >> fuel >> delimiter;
+        file >> priority >> delimiter;
+        file >> type >> delimiter;
+        file >> timestamp >> delimiter;
+        file >> landed >> delimiter;
+        file >> crashed;
+        file.ignore();  // Skip newline
+        
+        if (!file) {
+            break;  // Truncated or unreadable record
+        }
+        if (priority < int(Priority::CRITICAL) || priority > int(Priority::LOW) ||
+            type < int(AircraftType::COMMERCIAL) || type > int(AircraftType::EMERGENCY)) {
+            // Hand-edited or corrupt record; the report cannot describe it
+            rejected++;
+            continue;
+        }
+        
+        LogRecord record;
+        record.timestamp = timestamp;
+        record.flightID = strings.intern(flightID);
+        record.model = strings.intern(model);
+        record.origin = strings.intern(origin);
+        record.destination = strings.intern(destination);
+        record.finalFuel = float(fuel);
+        record.priority = (unsigned char)priority;
+        record.type = (unsigned char)type;
+        record.status = (landed == 1 ? LOG_LANDED : 0) | (crashed == 1 ? LOG_CRASHED : 0);
+        
+        // New landings must sort after everything loaded
+        Aircraft::reserveTimestamp(timestamp);
+        
+        insertRecord(record);
+    }
+    
+    file.close();
+    if (skipped != nullptr) {
+        *skipped = rejected;
+    }
+    return true;
+}
+
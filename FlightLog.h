@@ -0,0 +1,119 @@
+#ifndef FLIGHTLOG_H
+#define FLIGHTLOG_H
+
+#include "Aircraft.h"
+#include "StringInterner.h"
+#include <fstream>
+using namespace std;
+
+// Status bits of a LogRecord
+const unsigned char LOG_LANDED = 1;
+const unsigned char LOG_CRASHED = 2;
+
+// One flight log record: a fixed-size copy of what the report needs, so
+// the Aircraft itself can be released once it has landed. Text fields are
+// IDs in StringInterner::shared(), the same IDs the fleet uses.
+struct LogRecord {
+    long long timestamp;  // Arrival timestamp (sort key)
+    int flightID;
+    int model;
+    int origin;
+    int destination;
+    float finalFuel;
+    unsigned char priority;  // Priority value
+    unsigned char type;      // AircraftType value
+    unsigned char status;    // LOG_LANDED / LOG_CRASHED bits
+};
+
+// Fixed-size block of consecutive log records
+struct LogChunk {
+    static const int CAPACITY = 256;
+    LogRecord entries[CAPACITY];
+    int count;
+
+    LogChunk() : count(0) {}
+};
+
+// Append-optimized flight log.
+// Landing timestamps come from a monotonically increasing counter, so
+// almost every insert belongs at the end. Records are kept sorted in a
+// directory of fixed-size chunks: an in-order insert just fills the last
+// chunk (O(1)), and scans walk contiguous arrays. An out-of-order insert
+// (e.g. from loadFromFile) shifts records within one chunk, splitting it
+// when full. Same public interface as AVLTree, except entries are
+// LogRecords rather than Aircraft pointers.
+class FlightLog {
+private:
+    LogChunk** chunks;   // Chunk directory in timestamp order
+    int* chunkStart;     // Index of each chunk's first record in the whole log
+    int chunkCount;
+    int chunkCapacity;
+    int count;
+
+    StringInterner& strings;     // StringInterner::shared(), so fleet IDs carry over
+    long long* latestByFlight;   // Per string ID: newest timestamp logged for that flight (-1 = none)
+    int latestKnown;             // String IDs below this have a latestByFlight entry
+    int latestCapacity;
+
+    // Helper functions
+    void growDirectory();
+    LogChunk* appendChunk();
+    void insertChunkAfter(int chunkIndex, LogChunk* chunk);
+    void refreshStarts(int fromChunk);
+    int locate(long long timestamp, bool afterEqual) const;  // Global index of first record >= (or >) timestamp
+    bool insertRecord(const LogRecord& record);
+    void printEntry(const LogRecord* entry) const;
+
+    FlightLog(const FlightLog&);
+    FlightLog& operator=(const FlightLog&);
+
+public:
+    FlightLog();
+    ~FlightLog();
+
+    // Core operations
+    bool insert(const Aircraft* aircraft, long long timestamp);  // Copies what the log needs
+    void printInOrder() const;  // Chronological report
+
+    // Utility
+    bool isEmpty() const { return count == 0; }
+    void clear();
+
+    // Save/Load
+    bool saveToFile(const char* filename) const;
+    bool loadFromFile(const char* filename, int* skipped = nullptr);  // skipped: corrupt records dropped
+
+    // Order statistics
+    int countBefore(long long timestamp) const;  // Entries with timestamp < t
+    int countInRange(long long from, long long to) const;  // from <= timestamp <= to
+    int countSince(long long timestamp) const;   // Entries with timestamp >= t
+    const LogRecord* select(int index) const;     // index-th entry in time order (0-based)
+    const LogRecord* getNthMostRecent(int n) const;  // 1 = latest landing
+    int getChunkCount() const { return chunkCount; }
+
+    // Record lookup
+    const LogRecord* findLatest(const char* flightID) const;  // Newest entry for a flight, or nullptr
+    const char* getText(int stringID) const { return strings.lookup(stringID); }
+    const StringInterner& getStrings() const { return strings; }
+
+    // Iterates entries with from <= timestamp <= to in time order
+    class RangeIterator {
+    private:
+        const FlightLog& log;
+        int chunk;
+        int position;
+        long long upper;
+
+    public:
+        RangeIterator(const FlightLog& flightLog, long long from, long long to);
+
+        bool hasNext() const;
+        const LogRecord* next();  // nullptr when exhausted
+    };
+    void printRange(long long from, long long to) const;
+
+    int getLogCount() const { return count; }
+};
+
+#endif // FLIGHTLOG_H
+
@@ -1,31 +1,99 @@
 #include "Graph.h"
 #include "Aircraft.h"
+#include "RouteWorkspace.h"
+#include "Metrics.h"
 #include <cstring>
+#include <cmath>
 #include <iostream>
 using namespace std;
 
-Graph::Graph(int maxSize) : maxNodes(maxSize), nodeCount(0) {
+Graph::Graph(int maxSize) : maxNodes(maxSize > 0 ? maxSize : 1), nodeCount(0) {
     nodes = new GraphNode*[maxNodes];
     for (int i = 0; i < maxNodes; i++) {
         nodes[i] = nullptr;
     }
+    workspace = new RouteWorkspace(maxNodes);
+    scratchPath = new RoutePath();
+    
+    airportDistance = new double[maxNodes];
+    nearestAirport = new int[maxNodes];
+    nextHopToAirport = new int[maxNodes];
+    airportTableValid = false;
+    
+    edgeOffsets = new int[maxNodes + 1];
+    airportFlags = new bool[maxNodes];
+    packedX = new int[maxNodes];
+    packedY = new int[maxNodes];
+    heuristicScale = 0.0;
+    defaultAlgorithm = RouteAlgorithm::DIJKSTRA;
+    edgeTargets = nullptr;
+    edgeWeights = nullptr;
+    edgeCount = 0;
+    packedEdgeCapacity = 0;
+    packedValid = false;
 }
 
-Graph::~Graph() {
-    for (int i = 0; i < maxNodes; i++) {
-        delete nodes[i];
+void Graph::reserveNodes(int capacity) {
+    if (capacity <= maxNodes) {
+        return;
+    }
+    
+    GraphNode** newNodes = new GraphNode*[capacity];
+    for (int i = 0; i < capacity; i++) {
+        newNodes[i] = (i < nodeCount) ? nodes[i] : nullptr;
     }
     delete[] nodes;
+    nodes = newNodes;
+    
+    // The per-node search arrays are caches rebuilt from the lists, so they
+    // are reallocated without copying
+    delete[] airportDistance;
+    delete[] nearestAirport;
+    delete[] nextHopToAirport;
+    delete[] edgeOffsets;
+    delete[] airportFlags;
+    delete[] packedX;
+    delete[] packedY;
+    airportDistance = new double[capacity];
+    nearestAirport = new int[capacity];
+    nextHopToAirport = new int[capacity];
+    edgeOffsets = new int[capacity + 1];
+    airportFlags = new bool[capacity];
+    packedX = new int[capacity];
+    packedY = new int[capacity];
+    
+    maxNodes = capacity;
+    airportTableValid = false;
+    packedValid = false;
+}
+
+Graph::~Graph() {
+    // Nodes, edges and names go with their pools
+    delete[] nodes;
+    delete workspace;
+    delete scratchPath;
+    delete[] airportDistance;
+    delete[] nearestAirport;
+    delete[] nextHopToAirport;
+    delete[] edgeOffsets;
+    delete[] edgeTargets;
+    delete[] edgeWeights;
+    delete[] airportFlags;
+    delete[] packedX;
+    delete[] packedY;
 }
 
 int Graph::addNode(const char* name, bool isAirport, int gridX, int gridY) {
+    OperationTimer timer(Metric::GRAPH_ADD_NODE);
     if (nodeCount >= maxNodes) {
-        return -1;  // Graph is full
+        reserveNodes(maxNodes * 2);  // Geometric growth, amortized O(1)
     }
     
     int newNodeID = nodeCount;
-    nodes[nodeCount] = new GraphNode(newNodeID, name, isAirport, gridX, gridY);
+    nodes[nodeCount] = nodePool.create(newNodeID, nameArena.copy(name), isAirport, gridX, gridY);
     nodeCount++;
+    airportTableValid = false;
+    packedValid = false;
     return newNodeID;
 }
 
@@ -36,22 +104,43 @@ GraphNode* Graph::getNode(int nodeID) {
     return nodes[nodeID];
 }
 
+int Graph::findNodeByName(const char* name) {
+    if (name == nullptr) {
+        return -1;
+    }
+    for (int i = 0; i < nodeCount; i++) {
+        if (nodes[i] != nullptr && strcmp(nodes[i]->name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 bool Graph::nodeExists(int nodeID) {
     return nodeID >= 0 && nodeID < nodeCount && nodes[nodeID] != nullptr;
 }
 
 void Graph::addEdge(int from, int to, double weight) {
+    OperationTimer timer(Metric::GRAPH_ADD_EDGE);
     if (!nodeExists(from) || !nodeExists(to)) {
         return;
     }
     
     GraphNode* fromNode = nodes[from];
-    Edge* newEdge = new Edge(to, weight);
+    Edge* newEdge = edgePool.create(to, weight);
     newEdge->next = fromNode->edges;
     fromNode->edges = newEdge;
+    edgeCount++;
+    packedValid = false;
+    
+    // A new corridor only matters if it gives 'from' a shorter way out
+    if (airportTableValid && airportDistance[to] + weight < airportDistance[from]) {
+        airportTableValid = false;
+    }
 }
 
 void Graph::removeEdge(int from, int to) {
+    OperationTimer timer(Metric::GRAPH_REMOVE_EDGE);
     if (!nodeExists(from)) {
         return;
     }
@@ -67,7 +156,14 @@ void Graph::removeEdge(int from, int to) {
             } else {
                 fromNode->edges = current->next;
             }
-            delete current;
+            edgePool.destroy(current);
+            edgeCount--;
+            packedValid = false;
+            
+            // Only routes that used this corridor as their next hop change
+            if (airportTableValid && nextHopToAirport[from] == to) {
+                airportTableValid = false;
+            }
             return;
         }
         prev = current;
@@ -75,12 +171,81 @@ void Graph::removeEdge(int from, int to) {
     }
 }
 
+double Graph::getEdgeWeight(int from, int to) {
+    if (!nodeExists(from)) {
+        return -1.0;
+    }
+    
+    double best = -1.0;
+    for (Edge* edge = nodes[from]->edges; edge != nullptr; edge = edge->next) {
+        if (edge->destination == to && (best < 0 || edge->weight < best)) {
+            best = edge->weight;
+        }
+    }
+    return best;
+}
+
+void Graph::freeze() {
+    if (edgeCount > packedEdgeCapacity) {
+        // Grow geometrically so repeated edits don't reallocate every pack
+        int newCapacity = packedEdgeCapacity > 0 ? packedEdgeCapacity : 16;
+        while (newCapacity < edgeCount) {
+            newCapacity *= 2;
+        }
+        delete[] edgeTargets;
+        delete[] edgeWeights;
+        edgeTargets = new int[newCapacity];
+        edgeWeights = new double[newCapacity];
+        packedEdgeCapacity = newCapacity;
+    }
+    
+    // Copy each list in order so relaxation order matches the lists
+    int slot = 0;
+    for (int u = 0; u < nodeCount; u++) {
+        edgeOffsets[u] = slot;
+        airportFlags[u] = nodes[u]->isAirport;
+        packedX[u] = nodes[u]->gridX;
+        packedY[u] = nodes[u]->gridY;
+        for (Edge* edge = nodes[u]->edges; edge; edge = edge->next) {
+            edgeTargets[slot] = edge->destination;
+            edgeWeights[slot] = edge->weight;
+            slot++;
+        }
+    }
+    edgeOffsets[nodeCount] = slot;
+    
+    // Edge weights are km/fuel, not grid units, so scale the straight-line
+    // grid distance by the smallest weight-per-grid-unit over all edges.
+    // That keeps the heuristic admissible and consistent for any weights.
+    double scale = -1.0;
+    for (int u = 0; u < nodeCount && scale != 0.0; u++) {
+        for (int k = edgeOffsets[u]; k < edgeOffsets[u + 1]; k++) {
+            int v = edgeTargets[k];
+            double dx = packedX[u] - packedX[v];
+            double dy = packedY[u] - packedY[v];
+            double gridDistance = sqrt(dx * dx + dy * dy);
+            if (gridDistance == 0.0) {
+                continue;  // Coincident nodes put no bound on the scale
+            }
+            double ratio = edgeWeights[k] > 0.0 ? edgeWeights[k] / gridDistance : 0.0;
+            if (scale < 0.0 || ratio < scale) {
+                scale = ratio;
+            }
+        }
+    }
+    // Shave a little off so rounding can never make the estimate overshoot
+    heuristicScale = scale > 0.0 ? scale * (1.0 - 1e-9) : 0.0;
+    
+    packedValid = true;
+}
+
 bool Graph::placeAircraft(int nodeID, Aircraft* aircraft) {
+    OperationTimer timer(Metric::GRAPH_PLACE_AIRCRAFT);
     if (!nodeExists(nodeID) || isNodeOccupied(nodeID)) {
         return false;
     }
     
-    nodes[nodeID]->aircraft = aircraft;
+    nodes[nodeID]->occupant = aircraft ? aircraft->getHandle() : NO_AIRCRAFT;
     if (aircraft) {
         aircraft->setCurrentNodeID(nodeID);
         aircraft->setPosition(nodes[nodeID]->gridX, nodes[nodeID]->gridY);
@@ -89,11 +254,12 @@ bool Graph::placeAircraft(int nodeID, Aircraft* aircraft) {
 }
 
 bool Graph::removeAircraft(int nodeID) {
+    OperationTimer timer(Metric::GRAPH_REMOVE_AIRCRAFT);
     if (!nodeExists(nodeID)) {
         return false;
     }
     
-    nodes[nodeID]->aircraft = nullptr;
+    nodes[nodeID]->occupant = NO_AIRCRAFT;
     return true;
 }
 
@@ -101,138 +267,268 @@ Aircraft* Graph::getAircraftAtNode(int nodeID) {
     if (!nodeExists(nodeID)) {
         return nullptr;
     }
-    return nodes[nodeID]->aircraft;
+    return Aircraft::fromHandle(nodes[nodeID]->occupant);
 }
 
 bool Graph::isNodeOccupied(int nodeID) {
     if (!nodeExists(nodeID)) {
         return false;
     }
-    return nodes[nodeID]->aircraft != nullptr;
+    return nodes[nodeID]->occupant != NO_AIRCRAFT;
 }
 
-Graph::PathResult* Graph::findShortestPath(int start, int end) {
-    if (!nodeExists(start) || !nodeExists(end)) {
-        return nullptr;
-    }
+double Graph::heuristic(int nodeID, int end) const {
+    double dx = packedX[nodeID] - packedX[end];
+    double dy = packedY[nodeID] - packedY[end];
+    return heuristicScale * sqrt(dx * dx + dy * dy);
+}
+
+int Graph::runSearch(int start, int end, bool useHeuristic, RouteWorkspace& ws) {
+    ensurePacked();
     
-    // Dijkstra's algorithm
-    const double INF = 1e9;  // Large value instead of INT_MAX
-    double* distances = new double[nodeCount];
-    int* previous = new int[nodeCount];
-    bool* visited = new bool[nodeCount];
+    // A* only helps with a single target and a usable scale
+    useHeuristic = useHeuristic && end != -1 && heuristicScale > 0.0;
     
-    for (int i = 0; i < nodeCount; i++) {
-        distances[i] = INF;
-        previous[i] = -1;
-        visited[i] = false;
-    }
+    // Dijkstra's algorithm (A* when guided by the heuristic). Untouched
+    // nodes read back as INF from the workspace, so nothing is cleared here.
+    ws.begin(nodeCount);
+    NodeHeap& heap = ws.getHeap();
     
-    distances[start] = 0.0;
+    ws.setDistance(start, 0.0, -1);
+    heap.pushOrDecrease(start, useHeuristic ? heuristic(start, end) : 0.0);
     
-    for (int count = 0; count < nodeCount; count++) {
-        // Find unvisited node with minimum distance
-        int u = -1;
-        double minDist = INF;
-        for (int i = 0; i < nodeCount; i++) {
-            if (!visited[i] && distances[i] < minDist) {
-                minDist = distances[i];
-                u = i;
-            }
-        }
+    int settledTarget = -1;
+    int expanded = 0;
+    while (!heap.isEmpty()) {
+        // Settle unvisited node with minimum key (ties go to lowest ID)
+        int u = heap.extractMin();
+        expanded++;
         
-        if (u == -1 || u == end) break;
-        visited[u] = true;
+        // Target settled, its distance is final
+        if (u == end || (end == -1 && airportFlags[u])) {
+            settledTarget = u;
+            break;
+        }
+        ws.close(u);
         
         // Update distances to neighbors
-        Edge* edge = nodes[u]->edges;
-        while (edge) {
-            int v = edge->destination;
-            if (!visited[v] && distances[u] != INF) {
-                double alt = distances[u] + edge->weight;
-                if (alt < distances[v]) {
-                    distances[v] = alt;
-                    previous[v] = u;
+        double distU = ws.getDistance(u);
+        int edgeEnd = edgeOffsets[u + 1];
+        for (int k = edgeOffsets[u]; k < edgeEnd; k++) {
+            int v = edgeTargets[k];
+            if (!ws.isClosed(v)) {
+                double alt = distU + edgeWeights[k];
+                if (alt < ws.getDistance(v)) {
+                    ws.setDistance(v, alt, u);
+                    heap.pushOrDecrease(v, useHeuristic ? alt + heuristic(v, end) : alt);
                 }
             }
-            edge = edge->next;
         }
     }
     
-    // Reconstruct path
-    PathResult* result = new PathResult();
-    if (distances[end] == INF) {
-        delete[] distances;
-        delete[] previous;
-        delete[] visited;
-        return result;  // No path found
-    }
-    
-    result->totalDistance = distances[end];
+    recordMetric(Metric::GRAPH_NODES_EXPANDED, expanded);
+    return settledTarget;
+}
+
+void Graph::buildPath(int end, const RouteWorkspace& ws, RoutePath& path) {
+    path.totalDistance = ws.getDistance(end);
     
     // Count path length
     int pathLen = 0;
     int current = end;
     while (current != -1) {
         pathLen++;
-        current = previous[current];
+        current = ws.getPrevious(current);
     }
     
-    result->pathLength = pathLen;
-    result->path = new int[pathLen];
+    path.reserve(pathLen);
+    path.length = pathLen;
     
     // Build path array
     current = end;
     for (int i = pathLen - 1; i >= 0; i--) {
-        result->path[i] = current;
-        current = previous[current];
+        path.nodes[i] = current;
+        current = ws.getPrevious(current);
+    }
+}
+
+Graph::PathResult* Graph::toPathResult(const RoutePath& path) {
+    PathResult* result = new PathResult();
+    if (!path.found()) {
+        return result;  // No path found
     }
     
-    delete[] distances;
-    delete[] previous;
-    delete[] visited;
-    
+    result->totalDistance = path.totalDistance;
+    result->pathLength = path.length;
+    result->path = new int[path.length];
+    for (int i = 0; i < path.length; i++) {
+        result->path[i] = path.nodes[i];
+    }
     return result;
 }
 
+bool Graph::findShortestPath(int start, int end, RouteWorkspace& ws, RoutePath& path) {
+    return findShortestPath(start, end, defaultAlgorithm, ws, path);
+}
+
+bool Graph::findShortestPath(int start, int end, RouteAlgorithm algorithm,
+                             RouteWorkspace& ws, RoutePath& path) {
+    OperationTimer timer(Metric::GRAPH_SHORTEST_PATH);
+    path.length = 0;
+    path.totalDistance = 0.0;
+    if (!nodeExists(start) || !nodeExists(end)) {
+        return false;
+    }
+    
+    bool useHeuristic = algorithm == RouteAlgorithm::ASTAR;
+    if (runSearch(start, end, useHeuristic, ws) == -1) {
+        return false;
+    }
+    buildPath(end, ws, path);
+    return true;
+}
+
+bool Graph::findShortestPathToNearestAirport(int start, RouteWorkspace& ws, RoutePath& path) {
+    OperationTimer timer(Metric::GRAPH_NEAREST_AIRPORT);
+    path.length = 0;
+    path.totalDistance = 0.0;
+    if (!nodeExists(start)) {
+        return false;
+    }
+    
+    // Single search that stops at the first airport it settles. Ties between
+    // equally distant airports go to the lowest node ID.
+    int airport = runSearch(start, -1, false, ws);
+    if (airport == -1) {
+        return false;
+    }
+    buildPath(airport, ws, path);
+    return true;
+}
+
+Graph::PathResult* Graph::findShortestPath(int start, int end) {
+    return findShortestPath(start, end, defaultAlgorithm);
+}
+
+Graph::PathResult* Graph::findShortestPath(int start, int end, RouteAlgorithm algorithm) {
+    if (!nodeExists(start) || !nodeExists(end)) {
+        return nullptr;
+    }
+    
+    findShortestPath(start, end, algorithm, *workspace, *scratchPath);
+    return toPathResult(*scratchPath);
+}
+
 Graph::PathResult* Graph::findShortestPathToNearestAirport(int start) {
     if (!nodeExists(start)) {
         return nullptr;
     }
     
-    // Find all airports
-    int* airports = new int[nodeCount];
-    int airportCount = 0;
+    if (!findShortestPathToNearestAirport(start, *workspace, *scratchPath)) {
+        return nullptr;
+    }
+    return toPathResult(*scratchPath);
+}
+
+void Graph::rebuildAirportTable() {
+    const double INF = 1e9;
+    
+    for (int i = 0; i < nodeCount; i++) {
+        airportDistance[i] = INF;
+        nearestAirport[i] = -1;
+        nextHopToAirport[i] = -1;
+    }
     
+    // Reverse the packed edges into offset/source/weight arrays so the
+    // search can walk incoming edges
+    ensurePacked();
+    
+    int* inOffsets = new int[nodeCount + 1];
+    for (int i = 0; i <= nodeCount; i++) {
+        inOffsets[i] = 0;
+    }
+    for (int k = 0; k < edgeCount; k++) {
+        inOffsets[edgeTargets[k] + 1]++;
+    }
     for (int i = 0; i < nodeCount; i++) {
-        if (nodes[i] && nodes[i]->isAirport) {
-            airports[airportCount++] = i;
+        inOffsets[i + 1] += inOffsets[i];
+    }
+    
+    int* inSources = new int[edgeCount > 0 ? edgeCount : 1];
+    double* inWeights = new double[edgeCount > 0 ? edgeCount : 1];
+    int* fill = new int[nodeCount];
+    for (int i = 0; i < nodeCount; i++) {
+        fill[i] = inOffsets[i];
+    }
+    for (int u = 0; u < nodeCount; u++) {
+        for (int k = edgeOffsets[u]; k < edgeOffsets[u + 1]; k++) {
+            int slot = fill[edgeTargets[k]]++;
+            inSources[slot] = u;
+            inWeights[slot] = edgeWeights[k];
         }
     }
     
-    if (airportCount == 0) {
-        delete[] airports;
-        return nullptr;
+    // Multi-source Dijkstra from every airport over the reversed edges
+    NodeHeap& heap = workspace->getHeap();
+    workspace->begin(nodeCount);
+    for (int i = 0; i < nodeCount; i++) {
+        if (airportFlags[i]) {
+            airportDistance[i] = 0.0;
+            nearestAirport[i] = i;
+            heap.pushOrDecrease(i, 0.0);
+        }
     }
     
-    // Find shortest path to any airport
-    const double INF = 1e9;
-    PathResult* bestResult = nullptr;
-    double bestDistance = INF;
-    
-    for (int i = 0; i < airportCount; i++) {
-        PathResult* result = findShortestPath(start, airports[i]);
-        if (result && result->pathLength > 0 && result->totalDistance < bestDistance) {
-            if (bestResult) delete bestResult;
-            bestResult = result;
-            bestDistance = result->totalDistance;
-        } else if (result) {
-            delete result;
+    while (!heap.isEmpty()) {
+        int u = heap.extractMin();
+        for (int k = inOffsets[u]; k < inOffsets[u + 1]; k++) {
+            int w = inSources[k];
+            double alt = airportDistance[u] + inWeights[k];
+            if (alt < airportDistance[w]) {
+                airportDistance[w] = alt;
+                nearestAirport[w] = nearestAirport[u];
+                nextHopToAirport[w] = u;
+                heap.pushOrDecrease(w, alt);
+            }
         }
     }
     
-    delete[] airports;
-    return bestResult;
+    delete[] inOffsets;
+    delete[] inSources;
+    delete[] inWeights;
+    delete[] fill;
+    
+    airportTableValid = true;
+}
+
+int Graph::getNearestAirport(int nodeID) {
+    if (!nodeExists(nodeID)) {
+        return -1;
+    }
+    if (!airportTableValid) {
+        rebuildAirportTable();
+    }
+    return nearestAirport[nodeID];
+}
+
+int Graph::getNextHopToAirport(int nodeID) {
+    if (!nodeExists(nodeID)) {
+        return -1;
+    }
+    if (!airportTableValid) {
+        rebuildAirportTable();
+    }
+    return nextHopToAirport[nodeID];
+}
+
+double Graph::getDistanceToNearestAirport(int nodeID) {
+    if (!nodeExists(nodeID)) {
+        return -1.0;
+    }
+    if (!airportTableValid) {
+        rebuildAirportTable();
+    }
+    return nearestAirport[nodeID] == -1 ? -1.0 : airportDistance[nodeID];
 }
 
 void Graph::printGraph() {
@@ -242,8 +538,8 @@ void Graph::printGraph() {
             cout << "Node " << i << ": " << nodes[i]->name 
                       << " (" << (nodes[i]->isAirport ? "Airport" : "Waypoint") << ")"
                       << " at [" << nodes[i]->gridX << "," << nodes[i]->gridY << "]";
-            if (nodes[i]->aircraft) {
-                cout << " - Aircraft: " << nodes[i]->aircraft->getFlightID();
+            if (nodes[i]->occupant != NO_AIRCRAFT) {
+                cout << " - Aircraft: " << FleetStore::shared().getFlightID(nodes[i]->occupant);
             }
             cout << "\n";
             
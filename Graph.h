@@ -2,9 +2,19 @@
 #define GRAPH_H
 
 #include <cstring>
+#include "Pool.h"
+#include "FleetStore.h"
 
-// Forward declaration
+// Forward declarations
 class Aircraft;
+class RouteWorkspace;
+struct RoutePath;
+
+// Route search strategy for point-to-point queries
+enum class RouteAlgorithm {
+    DIJKSTRA,  // Expands outward from the start in distance order
+    ASTAR      // Dijkstra guided towards the target by grid distance
+};
 
 // Edge structure for adjacency list
 struct Edge {
@@ -15,51 +25,78 @@ struct Edge {
     Edge(int dest, double w) : destination(dest), weight(w), next(nullptr) {}
 };
 
-// Node structure for graph
+// Node structure for graph. Nodes, edges and names are owned by the
+// Graph's pools, so there is nothing to free per node.
 struct GraphNode {
     int nodeID;
-    char* name;
+    char* name;  // Stored in the Graph's name arena
     bool isAirport;  // true for airports, false for waypoints
     int gridX, gridY;  // Position on radar grid
-    Aircraft* aircraft;  // Aircraft currently at this node (nullptr if empty)
+    AircraftHandle occupant;  // Fleet handle of the aircraft at this node (NO_AIRCRAFT if empty)
     Edge* edges;  // Linked list of edges
     
-    GraphNode(int id, const char* n, bool airport, int x, int y)
-        : nodeID(id), isAirport(airport), gridX(x), gridY(y), aircraft(nullptr), edges(nullptr) {
-        name = new char[strlen(n) + 1];
-        strcpy(name, n);
-    }
-    
-    ~GraphNode() {
-        delete[] name;
-        Edge* current = edges;
-        while (current) {
-            Edge* next = current->next;
-            delete current;
-            current = next;
-        }
-    }
+    GraphNode(int id, char* n, bool airport, int x, int y)
+        : nodeID(id), name(n), isAirport(airport), gridX(x), gridY(y), occupant(NO_AIRCRAFT), edges(nullptr) {}
 };
 
-// Graph class (Adjacency List implementation)
+// Graph class (Adjacency List implementation, packed to CSR for routing)
 class Graph {
 private:
     GraphNode** nodes;  // Array of node pointers
-    int maxNodes;
+    int maxNodes;   // Current capacity of the node array
     int nodeCount;
+    ObjectPool<GraphNode, 64> nodePool;
+    ObjectPool<Edge> edgePool;
+    StringArena nameArena;
+    RouteWorkspace* workspace;  // Scratch state for the PathResult API and table builds
+    RoutePath* scratchPath;
+    
+    // Nearest-airport table, rebuilt lazily after the graph changes
+    double* airportDistance;  // Distance to the nearest reachable airport
+    int* nearestAirport;      // That airport's node ID (-1 if none reachable)
+    int* nextHopToAirport;    // First node on the way there (-1 at airports)
+    bool airportTableValid;
+    void rebuildAirportTable();
+    
+    // Packed (CSR) copy of the edge lists read by the search kernels.
+    // Edges of node u are [edgeOffsets[u], edgeOffsets[u + 1]).
+    int* edgeOffsets;
+    int* edgeTargets;
+    double* edgeWeights;
+    bool* airportFlags;   // isAirport per node, packed alongside the edges
+    int* packedX;         // gridX/gridY per node for the A* heuristic
+    int* packedY;
+    double heuristicScale;  // Largest k with k * gridDistance <= weight on every edge
+    int edgeCount;        // Total edges in the adjacency lists
+    int packedEdgeCapacity;
+    bool packedValid;     // False once addNode/addEdge/removeEdge change the graph
+    void ensurePacked() { if (!packedValid) freeze(); }
     
 public:
-    Graph(int maxSize = 100);
+    Graph(int maxSize = 100);  // Initial capacity; grows as nodes are added
     ~Graph();
     
     // Node operations
     int addNode(const char* name, bool isAirport, int gridX, int gridY);
+    void reserveNodes(int capacity);
     GraphNode* getNode(int nodeID);
     bool nodeExists(int nodeID);
+    int findNodeByName(const char* name);  // -1 if no node has that name
     
     // Edge operations
     void addEdge(int from, int to, double weight);
     void removeEdge(int from, int to);
+    double getEdgeWeight(int from, int to);  // Shortest direct edge, -1 if none
+    
+    // Pack nodes and edges into contiguous arrays for routing. Searches call
+    // this automatically when the graph changed since the last pack.
+    void freeze();
+    bool isFrozen() const { return packedValid; }
+    int getEdgeCount() const { return edgeCount; }
+    
+    // Default algorithm used by findShortestPath(start, end)
+    void setDefaultRouteAlgorithm(RouteAlgorithm algorithm) { defaultAlgorithm = algorithm; }
+    RouteAlgorithm getDefaultRouteAlgorithm() const { return defaultAlgorithm; }
     
     // Aircraft operations
     bool placeAircraft(int nodeID, Aircraft* aircraft);
@@ -67,7 +104,7 @@ public:
     Aircraft* getAircraftAtNode(int nodeID);
     bool isNodeOccupied(int nodeID);
     
-    // Dijkstra's algorithm for shortest path
+    // Dijkstra's algorithm for shortest path (binary heap, O((V + E) log V))
     struct PathResult {
         int* path;
         int pathLength;
@@ -78,11 +115,38 @@ public:
     };
     
     PathResult* findShortestPath(int start, int end);
-    PathResult* findShortestPathToNearestAirport(int start);
+    PathResult* findShortestPath(int start, int end, RouteAlgorithm algorithm);
+    PathResult* findShortestPathToNearestAirport(int start);  // Single search, stops at first airport
     
+    // Allocation-free variants: scratch state lives in the caller's workspace
+    // and the route is written to the caller's buffer. Return false if no route.
+    bool findShortestPath(int start, int end, RouteWorkspace& ws, RoutePath& path);
+    bool findShortestPath(int start, int end, RouteAlgorithm algorithm,
+                          RouteWorkspace& ws, RoutePath& path);
+    bool findShortestPathToNearestAirport(int start, RouteWorkspace& ws, RoutePath& path);
+    
+    // Nearest-airport lookups (O(1) while the graph is unchanged)
+    int getNearestAirport(int nodeID);
+    int getNextHopToAirport(int nodeID);
+    double getDistanceToNearestAirport(int nodeID);  // -1 if no airport reachable
+    
+private:
+    RouteAlgorithm defaultAlgorithm;
+    
+    // Search helpers; end == -1 stops at the first airport settled.
+    // With useHeuristic set the queue is keyed by distance + heuristic (A*).
+    int runSearch(int start, int end, bool useHeuristic, RouteWorkspace& ws);
+    double heuristic(int nodeID, int end) const;
+    void buildPath(int end, const RouteWorkspace& ws, RoutePath& path);
+    PathResult* toPathResult(const RoutePath& path);
+    
+public:
     // Utility
     int getNodeCount() const { return nodeCount; }
     int getMaxNodes() const { return maxNodes; }
+    const PoolStats& getNodePoolStats() const { return nodePool.getStats(); }
+    const PoolStats& getEdgePoolStats() const { return edgePool.getStats(); }
+    const PoolStats& getNameArenaStats() const { return nameArena.getStats(); }
     void printGraph();
 };
 
@@ -1,13 +1,23 @@
 #include "HashTable.h"
+#include "Metrics.h"
 #include <iostream>
 #include <cstring>
 using namespace std;
 
-HashTable::HashTable(int size) : tableSize(size), count(0) {
-    table = new HashNode*[tableSize];
-    for (int i = 0; i < tableSize; i++) {
-        table[i] = nullptr;
+HashTable::HashTable(int size, double maxLoad, double minLoad)
+    : tableCount(0), count(0), oldTable(nullptr), oldSize(0), oldMask(0),
+      oldCount(0), rehashCursor(0), rehashStep(4) {
+    tableSize = 8;
+    while (tableSize < size) {
+        tableSize *= 2;
     }
+    mask = tableSize - 1;
+    minTableSize = tableSize;
+    table = new HashNode[tableSize];
+    
+    maxLoadFactor = 0.85;
+    minLoadFactor = 0.20;
+    setLoadFactorThresholds(minLoad, maxLoad);
 }
 
 HashTable::~HashTable() {
@@ -15,111 +25,296 @@ HashTable::~HashTable() {
     delete[] table;
 }
 
-int HashTable::hashFunction(const char* key) const {
-    int sum = 0;
-    for (int i = 0; key[i] != '\0'; i++) {
-        sum += int(key[i]);
+int HashTable::findSlot(const HashNode* slots, int slotMask, const FlightId& key) {
+    unsigned int hash = key.hash();
+    int index = int(hash & slotMask);
+    for (int dist = 0; ; dist++) {
+        const HashNode& slot = slots[index];
+        
+        // Robin Hood invariant: the key would have displaced any entry
+        // closer to its home slot, so stop once we pass one
+        unsigned int slotHash = slot.key.hash();
+        if (slotHash == 0 || probeDistance(slotHash, index, slotMask) < dist) {
+            return -1;
+        }
+        if (slot.value != NO_AIRCRAFT && slot.key == key) {
+            return index;
+        }
+        index = (index + 1) & slotMask;
     }
-    return sum % tableSize;
 }
 
-bool HashTable::insert(const char* key, Aircraft* value) {
-    if (key == nullptr || value == nullptr) {
-        return false;
+void HashTable::placeEntry(HashNode* slots, int slotMask, HashNode entry) {
+    // Caller guarantees the key is absent and a free slot exists
+    int index = int(entry.key.hash() & slotMask);
+    int dist = 0;
+    while (slots[index].key.hash() != 0) {
+        if (probeDistance(slots[index].key.hash(), index, slotMask) < dist) {
+            HashNode displaced = slots[index];
+            slots[index] = entry;
+            entry = displaced;
+            dist = probeDistance(entry.key.hash(), index, slotMask);
+        }
+        index = (index + 1) & slotMask;
+        dist++;
+    }
+    slots[index] = entry;
+}
+
+void HashTable::removeFromCurrent(int index) {
+    // Backward-shift deletion: pull following entries one slot closer to
+    // home until an empty slot or an entry already at home
+    int next = (index + 1) & mask;
+    while (table[next].key.hash() != 0 && probeDistance(table[next].key.hash(), next, mask) > 0) {
+        table[index] = table[next];
+        index = next;
+        next = (next + 1) & mask;
+    }
+    table[index] = HashNode();
+    tableCount--;
+}
+
+void HashTable::startRehash(int newSize) {
+    if (oldTable != nullptr) {
+        finishRehash();
     }
     
-    // Check if key already exists
-    if (search(key) != nullptr) {
-        return false;  // Key already exists
+    oldTable = table;
+    oldSize = tableSize;
+    oldMask = mask;
+    oldCount = tableCount;
+    rehashCursor = 0;
+    
+    tableSize = newSize;
+    mask = tableSize - 1;
+    tableCount = 0;
+    table = new HashNode[tableSize];
+}
+
+void HashTable::rehashSome(int slots) {
+    if (oldTable == nullptr) {
+        return;
     }
     
-    int index = hashFunction(key);
-    HashNode* newNode = new HashNode(key, value);
-    newNode->next = table[index];
-    table[index] = newNode;
-    count++;
+    while (slots > 0 && rehashCursor < oldSize) {
+        HashNode& slot = oldTable[rehashCursor];
+        if (slot.value != NO_AIRCRAFT) {
+            placeEntry(table, mask, slot);
+            tableCount++;
+            oldCount--;
+            
+            // Keep the key so later probes in the old table still pass here
+            slot.value = NO_AIRCRAFT;
+        }
+        rehashCursor++;
+        slots--;
+    }
     
-    return true;
+    if (rehashCursor >= oldSize) {
+        delete[] oldTable;
+        oldTable = nullptr;
+        oldSize = 0;
+        oldMask = 0;
+        oldCount = 0;
+        rehashCursor = 0;
+    }
+}
+
+void HashTable::finishRehash() {
+    if (oldTable != nullptr) {
+        rehashSome(oldSize - rehashCursor);
+    }
+}
+
+void HashTable::checkLoad() {
+    if (oldTable != nullptr) {
+        return;  // One rehash at a time
+    }
+    
+    if (count > maxLoadFactor * tableSize) {
+        startRehash(tableSize * 2);
+    } else if (tableSize > minTableSize && count < minLoadFactor * tableSize) {
+        startRehash(tableSize / 2);
+    }
+}
+
+void HashTable::setLoadFactorThresholds(double minLoad, double maxLoad) {
+    // Keep the thresholds usable: growth must leave room for in-flight
+    // inserts, and shrinking must not immediately trigger growth again
+    if (maxLoad <= 0.0 || maxLoad > 0.95) {
+        maxLoad = 0.95;
+    }
+    if (minLoad < 0.0 || minLoad * 2.0 >= maxLoad) {
+        minLoad = maxLoad / 4.0;
+    }
+    maxLoadFactor = maxLoad;
+    minLoadFactor = minLoad;
+    checkLoad();
+}
+
+void HashTable::setRehashStep(int slotsPerOperation) {
+    rehashStep = slotsPerOperation > 0 ? slotsPerOperation : 1;
+}
+
+Aircraft* HashTable::findOrInsert(const FlightId& key, Aircraft* value, bool& inserted) {
+    OperationTimer timer(Metric::HASH_FIND_OR_INSERT);
+    return findOrInsertEntry(key, value, inserted);
 }
 
-Aircraft* HashTable::search(const char* key) const {
-    if (key == nullptr) {
+Aircraft* HashTable::findOrInsertEntry(const FlightId& key, Aircraft* value, bool& inserted) {
+    inserted = false;
+    if (key.isEmpty() || value == nullptr) {
         return nullptr;
     }
     
-    int index = hashFunction(key);
-    HashNode* current = table[index];
+    rehashSome(rehashStep);
     
-    while (current) {
-        if (strcmp(current->key, key) == 0) {
-            return current->value;
+    unsigned int hash = key.hash();
+    if (oldTable != nullptr) {
+        int oldIndex = findSlot(oldTable, oldMask, key);
+        if (oldIndex != -1) {
+            return Aircraft::fromHandle(oldTable[oldIndex].value);  // Key already exists
         }
-        current = current->next;
     }
     
+    int index = int(hash & mask);
+    int dist = 0;
+    
+    // Look for the key until we reach the slot where it would be inserted
+    while (true) {
+        HashNode& slot = table[index];
+        unsigned int slotHash = slot.key.hash();
+        if (slotHash == 0 || probeDistance(slotHash, index, mask) < dist) {
+            break;
+        }
+        if (slot.key == key) {
+            return Aircraft::fromHandle(slot.value);  // Key already exists
+        }
+        index = (index + 1) & mask;
+        dist++;
+    }
+    
+    if (tableCount >= tableSize) {
+        // Only reachable with a tiny rehash step; drain and grow now
+        finishRehash();
+        startRehash(tableSize * 2);
+        finishRehash();
+        return findOrInsertEntry(key, value, inserted);
+    }
+    
+    // Insert here and push displaced entries further along
+    HashNode carry;
+    carry.key = key;
+    carry.value = value->getHandle();
+    
+    while (table[index].key.hash() != 0) {
+        if (probeDistance(table[index].key.hash(), index, mask) < dist) {
+            HashNode displaced = table[index];
+            table[index] = carry;
+            carry = displaced;
+            dist = probeDistance(carry.key.hash(), index, mask);
+        }
+        index = (index + 1) & mask;
+        dist++;
+    }
+    table[index] = carry;
+    tableCount++;
+    count++;
+    
+    checkLoad();
+    
+    inserted = true;
+    return value;
+}
+
+bool HashTable::insert(const FlightId& key, Aircraft* value) {
+    OperationTimer timer(Metric::HASH_INSERT);
+    bool inserted;
+    findOrInsertEntry(key, value, inserted);
+    return inserted;
+}
+
+Aircraft* HashTable::search(const FlightId& key) const {
+    OperationTimer timer(Metric::HASH_SEARCH);
+    if (key.isEmpty()) {
+        return nullptr;
+    }
+    
+    int index = findSlot(table, mask, key);
+    if (index != -1) {
+        return Aircraft::fromHandle(table[index].value);
+    }
+    if (oldTable != nullptr) {
+        index = findSlot(oldTable, oldMask, key);
+        if (index != -1) {
+            return Aircraft::fromHandle(oldTable[index].value);
+        }
+    }
     return nullptr;
 }
 
-bool HashTable::remove(const char* key) {
-    if (key == nullptr) {
+bool HashTable::remove(const FlightId& key) {
+    OperationTimer timer(Metric::HASH_REMOVE);
+    if (key.isEmpty()) {
         return false;
     }
     
-    int index = hashFunction(key);
-    HashNode* current = table[index];
-    HashNode* prev = nullptr;
+    rehashSome(rehashStep);
     
-    while (current) {
-        if (strcmp(current->key, key) == 0) {
-            if (prev) {
-                prev->next = current->next;
-            } else {
-                table[index] = current->next;
-            }
-            delete current;
-            count--;
-            return true;
+    int index = findSlot(table, mask, key);
+    if (index != -1) {
+        removeFromCurrent(index);
+    } else {
+        if (oldTable == nullptr) {
+            return false;
         }
-        prev = current;
-        current = current->next;
+        index = findSlot(oldTable, oldMask, key);
+        if (index == -1) {
+            return false;
+        }
+        
+        // No backward shift here: it could move entries behind the rehash
+        // cursor. Leave the key as a marker, like a migrated slot.
+        oldTable[index].value = NO_AIRCRAFT;
+        oldCount--;
     }
+    count--;
     
-    return false;
+    checkLoad();
+    return true;
 }
 
-bool HashTable::update(const char* key, Aircraft* value) {
-    Aircraft* existing = search(key);
-    if (existing == nullptr) {
-        return false;
+bool HashTable::update(const FlightId& key, Aircraft* value) {
+    OperationTimer timer(Metric::HASH_UPDATE);
+    if (key.isEmpty() || value == nullptr) {
+        return false;  // Use remove() to drop an entry
     }
     
     // Update the value (Aircraft object is managed elsewhere)
-    // We just need to update the pointer if needed
-    int index = hashFunction(key);
-    HashNode* current = table[index];
-    
-    while (current) {
-        if (strcmp(current->key, key) == 0) {
-            current->value = value;
+    int index = findSlot(table, mask, key);
+    if (index != -1) {
+        table[index].value = value->getHandle();
+        return true;
+    }
+    if (oldTable != nullptr) {
+        index = findSlot(oldTable, oldMask, key);
+        if (index != -1) {
+            oldTable[index].value = value->getHandle();
             return true;
         }
-        current = current->next;
     }
-    
     return false;
 }
 
 void HashTable::printTable() const {
 cout << "\n=== Aircraft Registry (Hash Table) ===\n";
 cout << "Total aircraft: " << count << "\n\n";
-    
-    bool hasAircraft = false;
-    for (int i = 0; i < tableSize; i++) {
-        HashNode* current = table[i];
-        while (current) {
-            hasAircraft = true;
-            Aircraft* ac = current->value;
-cout << "Flight ID: " << current->key << "\n";
+
+    int aircraftCount;
+    Aircraft** allAircraft = getAllAircraft(aircraftCount);
+    for (int i = 0; i < aircraftCount; i++) {
+        Aircraft* ac = allAircraft[i];
+cout << "Flight ID: " << ac->getFlightID() << "\n";
 cout << "  Model: " << ac->getModel() << "\n";
 cout << "  Origin: " << ac->getOrigin() << "\n";
 cout << "  Destination: " << ac->getDestination() << "\n";
@@ -128,28 +323,64 @@ cout << "  Priority: " << ac->getPriorityString() << "\n";
 cout << "  Type: " << ac->getTypeString() << "\n";
 cout << "  Position: [" << ac->getCurrentX() << "," << ac->getCurrentY() << "]\n";
 cout << "\n";
-            current = current->next;
-        }
     }
+    delete[] allAircraft;
     
-    if (!hasAircraft) {
+    if (aircraftCount == 0) {
 cout << "No aircraft in registry.\n";
     }
 }
 
+void HashTable::printStats() const {
+cout << "\n=== Aircraft Registry Stats ===\n";
+cout << "Entries: " << count << "\n";
+cout << "Current table: " << tableSize << " slots, " << tableCount << " entries, load "
+     << getLoadFactor() << "\n";
+    if (oldTable != nullptr) {
+cout << "Rehash in progress: " << oldSize << " slots, " << oldCount << " entries left, "
+     << rehashCursor << "/" << oldSize << " slots moved\n";
+    } else {
+cout << "Rehash in progress: none\n";
+    }
+cout << "Load thresholds: shrink below " << minLoadFactor << ", grow above " << maxLoadFactor
+     << " (" << rehashStep << " slots moved per operation)\n";
+}
+
 void HashTable::clear() {
+    // Keys are stored inline, so clearing is just resetting the slots
     for (int i = 0; i < tableSize; i++) {
-        HashNode* current = table[i];
-        while (current) {
-            HashNode* next = current->next;
-            delete current;
-            current = next;
-        }
-        table[i] = nullptr;
+        table[i] = HashNode();
+    }
+    if (oldTable != nullptr) {
+        delete[] oldTable;
+        oldTable = nullptr;
+        oldSize = 0;
+        oldMask = 0;
+        oldCount = 0;
+        rehashCursor = 0;
     }
+    tableCount = 0;
     count = 0;
 }
 
+int HashTable::getLongestProbe() const {
+    int longest = 0;
+    for (int i = 0; i < tableSize; i++) {
+        unsigned int hash = table[i].key.hash();
+        if (hash != 0 && probeDistance(hash, i, mask) + 1 > longest) {
+            longest = probeDistance(hash, i, mask) + 1;
+        }
+    }
+    for (int i = 0; oldTable != nullptr && i < oldSize; i++) {
+        unsigned int hash = oldTable[i].key.hash();
+        if (hash != 0 && oldTable[i].value != NO_AIRCRAFT &&
+            probeDistance(hash, i, oldMask) + 1 > longest) {
+            longest = probeDistance(hash, i, oldMask) + 1;
+        }
+    }
+    return longest;
+}
+
 Aircraft** HashTable::getAllAircraft(int& aircraftCount) const {
     aircraftCount = count;
     if (count == 0) {
@@ -160,10 +391,15 @@ Aircraft** HashTable::getAllAircraft(int& aircraftCount) const {
     int index = 0;
     
     for (int i = 0; i < tableSize; i++) {
-        HashNode* current = table[i];
-        while (current) {
-            aircraftArray[index++] = current->value;
-            current = current->next;
+        if (table[i].key.hash() != 0) {
+            aircraftArray[index++] = Aircraft::fromHandle(table[i].value);
+        }
+    }
+    if (oldTable != nullptr) {
+        for (int i = 0; i < oldSize; i++) {
+            if (oldTable[i].value != NO_AIRCRAFT) {
+                aircraftArray[index++] = Aircraft::fromHandle(oldTable[i].value);
+            }
         }
     }
     
@@ -2,51 +2,96 @@
 #define HASHTABLE_H
 
 #include "Aircraft.h"
-#include <cstring>
+#include "FlightId.h"
 
-// Hash table node for chaining
+// Slot of the open-addressing table (24 bytes, key stored inline)
 struct HashNode {
-    char* key;  // Flight ID
-    Aircraft* value;
-    HashNode* next;
-    
-    HashNode(const char* k, Aircraft* v) : value(v), next(nullptr) {
-        key = new char[strlen(k) + 1];
-        strcpy(key, k);
-    }
-    
-    ~HashNode() {
-        delete[] key;
-        // Note: We don't delete Aircraft* as it's managed elsewhere
-    }
+    FlightId key;           // Flight ID; key.hash() doubles as the tag (0 = empty slot)
+    AircraftHandle value;   // Fleet handle (NO_AIRCRAFT with a tag = vacated during rehash)
+
+    HashNode() : value(NO_AIRCRAFT) {}
 };
 
-// Hash Table with chaining for O(1) lookup
+// Hash Table with Robin Hood open addressing for O(1) lookup.
+// Entries live in one flat slot array with the FlightId key inline, so
+// there is no per-entry allocation; the key's cached hash lets most probes
+// be rejected without comparing the text.
+//
+// The table grows (and shrinks) by itself when the load factor leaves the
+// configured range. Rehashing is incremental: a new table is allocated and
+// every operation moves a few slots across, so no single insert pays for
+// the whole table. Until the move finishes, lookups check both tables.
 class HashTable {
 private:
-    HashNode** table;
-    int tableSize;
-    int count;
-    
-    // Hash function: Sum of ASCII values modulo table size
-    int hashFunction(const char* key) const;
-    
+    HashNode* table;     // Current table, receives all inserts
+    int tableSize;       // Power of two
+    int mask;            // tableSize - 1
+    int tableCount;      // Live entries in the current table
+    int count;           // Live entries in both tables
+
+    HashNode* oldTable;  // Table being drained (nullptr when not rehashing)
+    int oldSize;
+    int oldMask;
+    int oldCount;        // Live entries not yet moved
+    int rehashCursor;    // Next old slot to move
+
+    int minTableSize;    // Never shrink below the initial size
+    double maxLoadFactor;
+    double minLoadFactor;
+    int rehashStep;      // Old slots moved per operation
+
+    static int probeDistance(unsigned int hash, int index, int tableMask) {
+        return (index - int(hash & tableMask)) & tableMask;
+    }
+    static int findSlot(const HashNode* slots, int slotMask, const FlightId& key);
+    static void placeEntry(HashNode* slots, int slotMask, HashNode entry);
+    void removeFromCurrent(int index);
+    Aircraft* findOrInsertEntry(const FlightId& key, Aircraft* value, bool& inserted);  // Untimed
+
+    // Incremental rehash
+    void startRehash(int newSize);
+    void rehashSome(int slots);
+    void finishRehash();
+    void checkLoad();
+
 public:
-    HashTable(int size = 101);  // Prime number for better distribution
+    HashTable(int size = 101, double maxLoad = 0.85, double minLoad = 0.20);  // Rounded up to a power of two
     ~HashTable();
-    
+
     // Core operations
-    bool insert(const char* key, Aircraft* value);
-    Aircraft* search(const char* key) const;
-    bool remove(const char* key);
-    bool update(const char* key, Aircraft* value);
-    
+    bool insert(const FlightId& key, Aircraft* value);
+    Aircraft* search(const FlightId& key) const;
+    bool remove(const FlightId& key);
+    bool update(const FlightId& key, Aircraft* value);
+
+    // Text keys; IDs longer than FlightId::MAX_LENGTH are never stored
+    bool insert(const char* key, Aircraft* value) { return insert(FlightId(key), value); }
+    Aircraft* search(const char* key) const { return search(FlightId(key)); }
+    bool remove(const char* key) { return remove(FlightId(key)); }
+    bool update(const char* key, Aircraft* value) { return update(FlightId(key), value); }
+
+    // Single probe sequence: returns the existing value for key, or stores
+    // value and returns it. 'inserted' tells which happened.
+    Aircraft* findOrInsert(const FlightId& key, Aircraft* value, bool& inserted);
+
+    // Growth policy
+    void setLoadFactorThresholds(double minLoad, double maxLoad);
+    void setRehashStep(int slotsPerOperation);
+    double getMaxLoadFactor() const { return maxLoadFactor; }
+    double getMinLoadFactor() const { return minLoadFactor; }
+
     // Utility
     int getCount() const { return count; }
     int getTableSize() const { return tableSize; }
+    double getLoadFactor() const { return double(tableCount) / tableSize; }
+    bool isRehashing() const { return oldTable != nullptr; }
+    int getRehashTableSize() const { return oldTable ? oldSize : 0; }
+    int getRehashRemaining() const { return oldTable ? oldCount : 0; }
+    int getLongestProbe() const;  // Slots probed by the worst-placed entry (O(table size))
     void printTable() const;
+    void printStats() const;
     void clear();
-    
+
     // For save/load
     Aircraft** getAllAircraft(int& count) const;
 };
@@ -0,0 +1,70 @@
+#ifndef LANDINGQUEUE_H
+#define LANDINGQUEUE_H
+
+#include "Aircraft.h"
+
+class HashTable;
+
+// Common interface for landing-queue implementations (MinHeap, BucketQueue).
+// Lower priority number = higher urgency; each implementation keeps the
+// aircraft's slot in Aircraft::queueIndex.
+class LandingQueue {
+protected:
+    const HashTable* registry;  // Resolves flight IDs to aircraft (nullptr = none)
+
+public:
+    LandingQueue() : registry(nullptr) {}
+    virtual ~LandingQueue() {}
+    
+    // Flight-ID overloads look the aircraft up here and then use its stored
+    // slot, O(log n) overall; with no registry attached they scan the queue
+    void setRegistry(const HashTable* flights) { registry = flights; }
+
+    // Core operations
+    virtual bool insert(Aircraft* aircraft) = 0;
+    virtual Aircraft* extractMin() = 0;  // Remove and return highest priority aircraft
+    virtual bool remove(Aircraft* aircraft) = 0;  // Remove from anywhere in the queue
+    virtual bool isEmpty() const = 0;
+    virtual int getSize() const = 0;
+    virtual int getDepth() const { return -1; }  // Tree levels, -1 if not tree-shaped
+
+    // Priority update
+    virtual bool decreaseKey(Aircraft* aircraft, Priority newPriority) = 0;
+    virtual bool updatePriority(Aircraft* aircraft, Priority newPriority) = 0;
+    virtual bool decreaseKey(const char* flightID, Priority newPriority) = 0;
+    virtual bool updatePriority(const char* flightID, Priority newPriority) = 0;
+
+    // Batch escalation: raise each aircraft to at least newPriority (never
+    // lowers it) and queue any that are not queued yet. Returns how many
+    // aircraft changed. Implementations may restore order once per batch.
+    virtual int escalateBatch(const AircraftHandle* handles, int count, Priority newPriority) {
+        int changed = 0;
+        for (int i = 0; i < count; i++) {
+            Aircraft* aircraft = Aircraft::fromHandle(handles[i]);
+            if (aircraft == nullptr) {
+                continue;
+            }
+            if (!contains(aircraft)) {
+                if (int(aircraft->getPriority()) > int(newPriority)) {
+                    aircraft->setPriority(newPriority);
+                }
+                changed += insert(aircraft) ? 1 : 0;
+            } else if (int(aircraft->getPriority()) > int(newPriority)) {
+                changed += updatePriority(aircraft, newPriority) ? 1 : 0;
+            }
+        }
+        return changed;
+    }
+    
+    // Access
+    virtual Aircraft* peek() const = 0;  // View top without removing
+    virtual bool contains(const Aircraft* aircraft) const = 0;
+    virtual bool contains(const char* flightID) const = 0;
+
+    // Utility
+    virtual void printHeap() const = 0;
+    virtual void clear() = 0;
+};
+
+#endif // LANDINGQUEUE_H
+
@@ -0,0 +1,244 @@
+#include "Metrics.h"
+#include <cstdio>
+using namespace std;
+
+Metrics Metrics::instance;
+
+const char* const Metrics::METRIC_NAMES[int(Metric::COUNT)] = {
+    "SkyNet::addFlight",
+    "SkyNet::declareEmergency",
+    "SkyNet::landFlight",
+    "SkyNet::searchFlight",
+    "SkyNet::findSafeRoute",
+    "SkyNet::moveAircraft",
+    "SkyNet::advanceTime",
+    "SkyNet::runSimulation",
+    "SkyNet::printConflictForecast",
+    "SkyNet::saveState",
+    "SkyNet::loadState",
+    "Graph::addNode",
+    "Graph::addEdge",
+    "Graph::removeEdge",
+    "Graph::placeAircraft",
+    "Graph::removeAircraft",
+    "Graph::findShortestPath",
+    "Graph::findShortestPathToNearestAirport",
+    "Graph::nodesExpanded",
+    "LandingQueue::insert",
+    "LandingQueue::extractMin",
+    "LandingQueue::updatePriority",
+    "LandingQueue::remove",
+    "HashTable::insert",
+    "HashTable::search",
+    "HashTable::remove",
+    "HashTable::update",
+    "HashTable::findOrInsert",
+    "FlightLog::insert",
+    "FlightLog::countInRange",
+    "FlightLog::saveToFile",
+    "FlightLog::loadFromFile"
+};
+
+const char* const Metrics::GAUGE_NAMES[int(Gauge::COUNT)] = {
+    "hash_entries",
+    "hash_table_size",
+    "hash_load_factor",
+    "hash_longest_probe",
+    "heap_size",
+    "heap_depth",
+    "log_entries",
+    "log_chunks",
+    "airspace_nodes",
+    "active_flights"
+};
+
+Histogram::Histogram() {
+    reset();
+}
+
+void Histogram::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = 0;
+    }
+    total = 0;
+    minimum = 0;
+    maximum = 0;
+    sum = 0.0;
+}
+
+int Histogram::bucketFor(unsigned long long value) {
+    if (value < (unsigned long long)SUB_COUNT) {
+        return int(value);
+    }
+    
+    // Position of the highest set bit, by halving
+    int top = 0;
+    unsigned long long rest = value;
+    for (int shift = 32; shift > 0; shift >>= 1) {
+        if (rest >> shift) {
+            rest >>= shift;
+            top += shift;
+        }
+    }
+    
+    // The top SUB_BITS + 1 bits pick the sub-bucket within that power of two
+    int sub = int(value >> (top - SUB_BITS)) - SUB_COUNT;
+    return (top - SUB_BITS + 1) * SUB_COUNT + sub;
+}
+
+unsigned long long Histogram::bucketTop(int bucket) {
+    if (bucket < SUB_COUNT) {
+        return (unsigned long long)bucket;
+    }
+    int top = bucket / SUB_COUNT + SUB_BITS - 1;
+    unsigned long long sub = (unsigned long long)(bucket % SUB_COUNT);
+    // Wraps to the largest value for the very last bucket
+    return ((SUB_COUNT + sub + 1) << (top - SUB_BITS)) - 1;
+}
+
+void Histogram::record(unsigned long long value) {
+    counts[bucketFor(value)]++;
+    if (total == 0 || value < minimum) {
+        minimum = value;
+    }
+    if (value > maximum) {
+        maximum = value;
+    }
+    total++;
+    sum += double(value);
+}
+
+unsigned long long Histogram::getPercentile(double percent) const {
+    if (total == 0) {
+        return 0;
+    }
+    
+    // Rank of the wanted value, 1-based, at least the first one
+    unsigned long long rank = (unsigned long long)(percent / 100.0 * double(total) + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+    
+    unsigned long long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            unsigned long long value = bucketTop(i);
+            return value < maximum ? value : maximum;
+        }
+    }
+    return maximum;
+}
+
+Metrics::Metrics() : enabled(true) {
+    for (int i = 0; i < int(Metric::COUNT); i++) {
+        calls[i] = 0;
+        sampleInterval[i] = 1;
+        countdown[i] = 1;
+    }
+    for (int i = 0; i < int(Gauge::COUNT); i++) {
+        gauges[i] = 0.0;
+        gaugeSet[i] = false;
+    }
+    
+    // Operations that take well under a microsecond
+    const Metric sampled[] = {
+        Metric::GRAPH_ADD_NODE, Metric::GRAPH_ADD_EDGE, Metric::GRAPH_REMOVE_EDGE,
+        Metric::GRAPH_PLACE_AIRCRAFT, Metric::GRAPH_REMOVE_AIRCRAFT,
+        Metric::HEAP_INSERT, Metric::HEAP_EXTRACT_MIN, Metric::HEAP_UPDATE_PRIORITY,
+        Metric::HEAP_REMOVE, Metric::HASH_INSERT, Metric::HASH_SEARCH, Metric::HASH_REMOVE,
+        Metric::HASH_UPDATE, Metric::HASH_FIND_OR_INSERT, Metric::LOG_APPEND,
+        Metric::LOG_RANGE
+    };
+    for (unsigned int i = 0; i < sizeof(sampled) / sizeof(sampled[0]); i++) {
+        setSampleInterval(sampled[i], SAMPLE_EVERY);
+    }
+}
+
+void Metrics::setSampleInterval(Metric metric, int every) {
+    int i = int(metric);
+    sampleInterval[i] = every > 0 ? every : 1;
+    countdown[i] = 1;  // Time the next call, so even rare operations get a sample
+}
+
+bool Metrics::isValueMetric(Metric metric) {
+    return metric == Metric::GRAPH_NODES_EXPANDED;
+}
+
+void Metrics::reset() {
+    for (int i = 0; i < int(Metric::COUNT); i++) {
+        histograms[i].reset();
+        calls[i] = 0;
+        countdown[i] = 1;
+    }
+}
+
+void Metrics::print(ostream& out) const {
+    char line[160];
+out << "\n=== Operation Latency (us) ===\n";
+    snprintf(line, sizeof(line), "%-40s %9s %8s %9s %9s %9s %9s %9s\n",
+             "operation", "calls", "sampled", "mean", "p50", "p90", "p99", "max");
+out << line;
+
+    bool any = false;
+    for (int i = 0; i < int(Metric::COUNT); i++) {
+        const Histogram& h = histograms[i];
+        if (h.getCount() == 0) {
+            continue;
+        }
+        any = true;
+        
+        // Latencies print in microseconds, counts as they are
+        double scale = isValueMetric(Metric(i)) ? 1.0 : 1000.0;
+        snprintf(line, sizeof(line), "%-40s %9llu %8llu %9.2f %9.2f %9.2f %9.2f %9.2f%s\n",
+                 METRIC_NAMES[i], calls[i], h.getCount(), h.getMean() / scale,
+                 h.getPercentile(50.0) / scale, h.getPercentile(90.0) / scale,
+                 h.getPercentile(99.0) / scale, h.getMax() / scale,
+                 isValueMetric(Metric(i)) ? "  (nodes)" : "");
+out << line;
+    }
+    if (!any) {
+out << "No operations recorded" << (enabled ? "" : " (metrics disabled)") << ".\n";
+    }
+
+out << "\n=== Structure Gauges ===\n";
+    for (int i = 0; i < int(Gauge::COUNT); i++) {
+        if (gaugeSet[i]) {
+out << GAUGE_NAMES[i] << ": " << gauges[i] << "\n";
+        }
+    }
+}
+
+void Metrics::writeJson(ostream& out) const {
+    char line[320];
+    out << "{\n  \"enabled\": " << (enabled ? "true" : "false") << ",\n  \"operations\": [";
+    
+    bool first = true;
+    for (int i = 0; i < int(Metric::COUNT); i++) {
+        const Histogram& h = histograms[i];
+        if (h.getCount() == 0) {
+            continue;
+        }
+        snprintf(line, sizeof(line),
+                 "%s\n    {\"name\": \"%s\", \"unit\": \"%s\", \"calls\": %llu, "
+                 "\"samples\": %llu, \"min\": %llu, \"mean\": %.1f, \"p50\": %llu, "
+                 "\"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}",
+                 first ? "" : ",", METRIC_NAMES[i], isValueMetric(Metric(i)) ? "nodes" : "ns",
+                 calls[i], h.getCount(), h.getMin(), h.getMean(), h.getPercentile(50.0),
+                 h.getPercentile(90.0), h.getPercentile(99.0), h.getPercentile(99.9), h.getMax());
+        out << line;
+        first = false;
+    }
+    
+    out << "\n  ],\n  \"gauges\": {";
+    first = true;
+    for (int i = 0; i < int(Gauge::COUNT); i++) {
+        if (!gaugeSet[i]) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "%s\n    \"%s\": %.6g", first ? "" : ",", GAUGE_NAMES[i], gauges[i]);
+        out << line;
+        first = false;
+    }
+    out << "\n  }\n}\n";
+}
+
@@ -0,0 +1,210 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+// Everything that is measured. Latencies are in nanoseconds; the few
+// value metrics (marked below) record a count per call instead.
+enum class Metric {
+    // SkyNet core operations
+    SKYNET_ADD_FLIGHT,
+    SKYNET_DECLARE_EMERGENCY,
+    SKYNET_LAND_FLIGHT,
+    SKYNET_SEARCH_FLIGHT,
+    SKYNET_FIND_SAFE_ROUTE,
+    SKYNET_MOVE_AIRCRAFT,
+    SKYNET_ADVANCE_TIME,
+    SKYNET_RUN_SIMULATION,
+    SKYNET_CONFLICT_FORECAST,
+    SKYNET_SAVE_STATE,
+    SKYNET_LOAD_STATE,
+    // Graph
+    GRAPH_ADD_NODE,
+    GRAPH_ADD_EDGE,
+    GRAPH_REMOVE_EDGE,
+    GRAPH_PLACE_AIRCRAFT,
+    GRAPH_REMOVE_AIRCRAFT,
+    GRAPH_SHORTEST_PATH,
+    GRAPH_NEAREST_AIRPORT,
+    GRAPH_NODES_EXPANDED,   // Value: nodes settled per route search
+    // Landing queue (MinHeap or BucketQueue, whichever SkyNet was built with)
+    HEAP_INSERT,
+    HEAP_EXTRACT_MIN,
+    HEAP_UPDATE_PRIORITY,
+    HEAP_REMOVE,
+    // HashTable
+    HASH_INSERT,
+    HASH_SEARCH,
+    HASH_REMOVE,
+    HASH_UPDATE,
+    HASH_FIND_OR_INSERT,
+    // FlightLog
+    LOG_APPEND,
+    LOG_RANGE,
+    LOG_SAVE,
+    LOG_LOAD,
+    
+    COUNT
+};
+
+// Point-in-time structure sizes, set by their owners when stats are read
+enum class Gauge {
+    HASH_ENTRIES,
+    HASH_TABLE_SIZE,
+    HASH_LOAD_FACTOR,
+    HASH_LONGEST_PROBE,     // Longest probe sequence in the table
+    HEAP_SIZE,
+    HEAP_DEPTH,
+    LOG_ENTRIES,
+    LOG_CHUNKS,
+    AIRSPACE_NODES,
+    ACTIVE_FLIGHTS,
+    
+    COUNT
+};
+
+// HDR-style histogram: every power of two is split into 16 linear
+// sub-buckets, so any recorded value is known to within 1/16 (6.25%)
+// over the full 64-bit range, in a fixed ~8 KB with no allocation.
+// Percentiles report the top of the bucket they fall in (never below
+// the true value), clamped to the largest value seen.
+class Histogram {
+private:
+    static const int SUB_BITS = 4;
+    static const int SUB_COUNT = 1 << SUB_BITS;
+    static const int BUCKET_COUNT = (64 - SUB_BITS + 1) * SUB_COUNT;
+    
+    unsigned long long counts[BUCKET_COUNT];
+    unsigned long long total;
+    unsigned long long minimum;
+    unsigned long long maximum;
+    double sum;
+    
+    static int bucketFor(unsigned long long value);
+    static unsigned long long bucketTop(int bucket);
+
+public:
+    Histogram();
+    
+    void record(unsigned long long value);
+    void reset();
+    
+    unsigned long long getCount() const { return total; }
+    unsigned long long getMin() const { return total > 0 ? minimum : 0; }
+    unsigned long long getMax() const { return maximum; }
+    double getMean() const { return total > 0 ? sum / total : 0.0; }
+    unsigned long long getPercentile(double percent) const;  // 0-100
+};
+
+// Process-wide histograms and gauges. Every call is counted, but reading
+// the clock costs more than a hash lookup, so the cheap structure
+// operations only time one call in SAMPLE_EVERY (the histogram then holds
+// an unbiased sample). Timers can be switched off at run time (one branch
+// per operation) or compiled out entirely with -DSKYNET_NO_METRICS.
+class Metrics {
+private:
+    static const char* const METRIC_NAMES[int(Metric::COUNT)];
+    static const char* const GAUGE_NAMES[int(Gauge::COUNT)];
+    static const int SAMPLE_EVERY = 16;
+    
+    Histogram histograms[int(Metric::COUNT)];
+    unsigned long long calls[int(Metric::COUNT)];
+    int sampleInterval[int(Metric::COUNT)];
+    int countdown[int(Metric::COUNT)];  // Calls until the next timed one
+    double gauges[int(Gauge::COUNT)];
+    bool gaugeSet[int(Gauge::COUNT)];
+    bool enabled;
+    
+    static Metrics instance;
+    
+    static bool isValueMetric(Metric metric);
+    
+    Metrics(const Metrics&);
+    Metrics& operator=(const Metrics&);
+
+public:
+    Metrics();
+    
+    static Metrics& shared() { return instance; }
+    
+    void setEnabled(bool on) { enabled = on; }
+    bool isEnabled() const { return enabled; }
+    
+    // Counts the call; true if this one should be measured and recorded
+    bool shouldSample(Metric metric) {
+        if (!enabled) {
+            return false;
+        }
+        int i = int(metric);
+        calls[i]++;
+        if (--countdown[i] > 0) {
+            return false;
+        }
+        countdown[i] = sampleInterval[i];
+        return true;
+    }
+    void record(Metric metric, unsigned long long value) {
+        histograms[int(metric)].record(value);
+    }
+    void setSampleInterval(Metric metric, int every);  // 1 = time every call
+    void setGauge(Gauge gauge, double value) {
+        gauges[int(gauge)] = value;
+        gaugeSet[int(gauge)] = true;
+    }
+    
+    const Histogram& get(Metric metric) const { return histograms[int(metric)]; }
+    unsigned long long getCalls(Metric metric) const { return calls[int(metric)]; }
+    double getGauge(Gauge gauge) const { return gauges[int(gauge)]; }
+    void reset();  // Clears histograms and call counts; gauges keep their last values
+    
+    // Operations that ran at least once, then the gauges
+    void print(ostream& out) const;
+    void writeJson(ostream& out) const;
+};
+
+// Times its enclosing scope into one metric
+class OperationTimer {
+#ifndef SKYNET_NO_METRICS
+private:
+    Metric metric;
+    bool running;
+    chrono::steady_clock::time_point start;
+
+public:
+    explicit OperationTimer(Metric timed) : metric(timed), running(Metrics::shared().shouldSample(timed)) {
+        if (running) {
+            start = chrono::steady_clock::now();
+        }
+    }
+    ~OperationTimer() {
+        if (running) {
+            Metrics::shared().record(metric, (unsigned long long)chrono::duration_cast<
+                chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        }
+    }
+#else
+public:
+    explicit OperationTimer(Metric) {}
+#endif
+
+private:
+    OperationTimer(const OperationTimer&);
+    OperationTimer& operator=(const OperationTimer&);
+};
+
+// Value metrics share the switch with the timers
+inline void recordMetric(Metric metric, unsigned long long value) {
+#ifndef SKYNET_NO_METRICS
+    if (Metrics::shared().shouldSample(metric)) {
+        Metrics::shared().record(metric, value);
+    }
+#else
+    (void)metric;
+    (void)value;
+#endif
+}
+
+#endif // METRICS_H
+
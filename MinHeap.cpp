@@ -1,30 +1,38 @@
 #include "MinHeap.h"
+#include "HashTable.h"
+#include "Metrics.h"
 #include <iostream>
 #include <cstring>
 using namespace std;
 
-MinHeap::MinHeap(int cap) : capacity(cap), size(0) {
-    heap = new Aircraft*[capacity];
-    heapIndices = new int[capacity];
-    for (int i = 0; i < capacity; i++) {
-        heap[i] = nullptr;
-        heapIndices[i] = -1;
-    }
+MinHeap::MinHeap(int cap) : fleet(FleetStore::shared()), capacity(cap > 0 ? cap : 1), size(0) {
+    heap = new AircraftHandle[capacity];
 }
 
 MinHeap::~MinHeap() {
     // Note: We don't delete Aircraft objects here as they're managed elsewhere
     delete[] heap;
-    delete[] heapIndices;
 }
 
 void MinHeap::swap(int i, int j) {
-    Aircraft* temp = heap[i];
+    AircraftHandle temp = heap[i];
     heap[i] = heap[j];
     heap[j] = temp;
     
-    // Update indices if we're tracking them
-    // For simplicity, we'll rebuild indices after operations
+    // Keep each aircraft's stored position in sync
+    fleet.setQueueIndex(heap[i], i);
+    fleet.setQueueIndex(heap[j], j);
+}
+
+void MinHeap::grow() {
+    int newCapacity = capacity * 2;
+    AircraftHandle* newHeap = new AircraftHandle[newCapacity];
+    for (int i = 0; i < size; i++) {
+        newHeap[i] = heap[i];
+    }
+    delete[] heap;
+    heap = newHeap;
+    capacity = newCapacity;
 }
 
 void MinHeap::heapifyUp(int index) {
@@ -32,8 +40,8 @@ void MinHeap::heapifyUp(int index) {
         int parentIdx = parent(index);
         
         // Compare priorities (lower number = higher priority)
-        int currentPriority = int(heap[index]->getPriority());
-        int parentPriority = int(heap[parentIdx]->getPriority());
+        int currentPriority = priorityAt(index);
+        int parentPriority = priorityAt(parentIdx);
         
         if (currentPriority < parentPriority) {
             swap(index, parentIdx);
@@ -50,28 +58,25 @@ void MinHeap::heapifyDown(int index) {
         int left = leftChild(index);
         int right = rightChild(index);
         
-        int indexPriority = int(heap[index]->getPriority());
+        int indexPriority = priorityAt(index);
         
         if (left < size) {
-            int leftPriority = int(heap[left]->getPriority());
+            int leftPriority = priorityAt(left);
             if (leftPriority < indexPriority) {
                 smallest = left;
             }
         }
         
         if (right < size) {
-            int rightPriority = int(heap[right]->getPriority());
-            int smallestPriority = int(heap[smallest]->getPriority());
+            int rightPriority = priorityAt(right);
+            int smallestPriority = priorityAt(smallest);
             if (rightPriority < smallestPriority) {
                 smallest = right;
             }
         }
         
         if (smallest != index) {
-            // Manual in-place swap without using built-in swap function
-            Aircraft* temp = heap[index];
-            heap[index] = heap[smallest];
-            heap[smallest] = temp;
+            swap(index, smallest);
             index = smallest;
         } else {
             break;
@@ -80,11 +85,19 @@ void MinHeap::heapifyDown(int index) {
 }
 
 bool MinHeap::insert(Aircraft* aircraft) {
-    if (size >= capacity || aircraft == nullptr) {
+    OperationTimer timer(Metric::HEAP_INSERT);
+    if (aircraft == nullptr) {
         return false;
     }
+    if (aircraft->getQueueIndex() != -1) {
+        return false;  // Already queued
+    }
+    if (size >= capacity) {
+        grow();
+    }
     
-    heap[size] = aircraft;
+    heap[size] = aircraft->getHandle();
+    aircraft->setQueueIndex(size);
     size++;
     heapifyUp(size - 1);
     
@@ -92,80 +105,196 @@ bool MinHeap::insert(Aircraft* aircraft) {
 }
 
 Aircraft* MinHeap::extractMin() {
+    OperationTimer timer(Metric::HEAP_EXTRACT_MIN);
     if (size == 0) {
         return nullptr;
     }
     
-    Aircraft* min = heap[0];
+    AircraftHandle min = heap[0];
     heap[0] = heap[size - 1];
-    heap[size - 1] = nullptr;
+    fleet.setQueueIndex(heap[0], 0);
     size--;
+    fleet.setQueueIndex(min, -1);
     
     if (size > 0) {
         heapifyDown(0);
     }
     
-    return min;
+    return fleet.getAircraft(min);
+}
+
+bool MinHeap::remove(Aircraft* aircraft) {
+    OperationTimer timer(Metric::HEAP_REMOVE);
+    int index = findIndex(aircraft);
+    if (index == -1) {
+        return false;
+    }
+    
+    // Move the last entry into the hole, then restore order in whichever
+    // direction it is out of place
+    size--;
+    if (index != size) {
+        heap[index] = heap[size];
+        fleet.setQueueIndex(heap[index], index);
+        heapifyUp(index);
+        heapifyDown(index);
+    }
+    aircraft->setQueueIndex(-1);
+    return true;
+}
+
+// A binary heap of n entries is floor(log2 n) + 1 levels deep
+int MinHeap::getDepth() const {
+    int depth = 0;
+    while ((1 << depth) <= size) {
+        depth++;
+    }
+    return depth;
 }
 
 Aircraft* MinHeap::peek() const {
     if (size == 0) {
         return nullptr;
     }
-    return heap[0];
+    return fleet.getAircraft(heap[0]);
+}
+
+bool MinHeap::contains(const Aircraft* aircraft) const {
+    return findIndex(aircraft) != -1;
 }
 
 bool MinHeap::contains(const char* flightID) const {
-    for (int i = 0; i < size; i++) {
-        if (heap[i] && strcmp(heap[i]->getFlightID(), flightID) == 0) {
-            return true;
-        }
+    return findIndex(flightID) != -1;
+}
+
+int MinHeap::findIndex(const Aircraft* aircraft) const {
+    if (aircraft == nullptr) {
+        return -1;
+    }
+    
+    // Verify the slot so an aircraft queued elsewhere isn't mistaken for ours
+    int index = aircraft->getQueueIndex();
+    if (index >= 0 && index < size && heap[index] == aircraft->getHandle()) {
+        return index;
     }
-    return false;
+    return -1;
 }
 
 int MinHeap::findIndex(const char* flightID) const {
+    FlightId id(flightID);
+    if (id.isEmpty()) {
+        return -1;
+    }
+    if (registry != nullptr) {
+        return findIndex(registry->search(id));
+    }
     for (int i = 0; i < size; i++) {
-        if (heap[i] && strcmp(heap[i]->getFlightID(), flightID) == 0) {
+        if (fleet.getFlightId(heap[i]) == id) {
             return i;
         }
     }
     return -1;
 }
 
-bool MinHeap::decreaseKey(const char* flightID, Priority newPriority) {
-    int index = findIndex(flightID);
+bool MinHeap::decreaseKey(Aircraft* aircraft, Priority newPriority) {
+    int index = findIndex(aircraft);
     if (index == -1) {
         return false;
     }
     
-    Priority oldPriority = heap[index]->getPriority();
-    if (int(newPriority) >= int(oldPriority)) {
+    if (int(newPriority) >= priorityAt(index)) {
         return false;  // Not a decrease
     }
     
-    heap[index]->setPriority(newPriority);
+    aircraft->setPriority(newPriority);
     heapifyUp(index);
     
     return true;
 }
 
+bool MinHeap::updatePriority(Aircraft* aircraft, Priority newPriority) {
+    OperationTimer timer(Metric::HEAP_UPDATE_PRIORITY);
+    int index = findIndex(aircraft);
+    if (index == -1) {
+        return false;
+    }
+    
+    // The aircraft's priority may already have been changed directly (e.g.
+    // declareEmergency), so restore the heap property in both directions
+    aircraft->setPriority(newPriority);
+    heapifyUp(index);
+    heapifyDown(aircraft->getQueueIndex());
+    
+    return true;
+}
+
+bool MinHeap::decreaseKey(const char* flightID, Priority newPriority) {
+    int index = findIndex(flightID);
+    if (index == -1) {
+        return false;
+    }
+    return decreaseKey(fleet.getAircraft(heap[index]), newPriority);
+}
+
 bool MinHeap::updatePriority(const char* flightID, Priority newPriority) {
     int index = findIndex(flightID);
     if (index == -1) {
         return false;
     }
+    return updatePriority(fleet.getAircraft(heap[index]), newPriority);
+}
+
+void MinHeap::rebuild() {
+    for (int i = size / 2 - 1; i >= 0; i--) {
+        heapifyDown(i);
+    }
+}
+
+int MinHeap::escalateBatch(const AircraftHandle* handles, int count, Priority newPriority) {
+    int target = int(newPriority);
+    int changed = 0;
     
-    Priority oldPriority = heap[index]->getPriority();
-    heap[index]->setPriority(newPriority);
+    // Large batches: raise everything, then one O(n) rebuild. Small ones
+    // sift each aircraft up as soon as it changes, so every sift starts
+    // from a valid heap (a parent raised later cannot strand its child).
+    bool bulk = count * 8 > size + count;
     
-    if (int(newPriority) < int(oldPriority)) {
-        heapifyUp(index);
-    } else {
-        heapifyDown(index);
+    for (int i = 0; i < count; i++) {
+        AircraftHandle h = handles[i];
+        if (fleet.getAircraft(h) == nullptr) {
+            continue;
+        }
+        bool queued = fleet.getQueueIndex(h) >= 0 && fleet.getQueueIndex(h) < size &&
+                      heap[fleet.getQueueIndex(h)] == h;
+        bool raise = fleet.getPriority(h) > target;
+        if (!queued) {
+            if (fleet.getQueueIndex(h) != -1) {
+                continue;  // Queued somewhere else
+            }
+            if (size >= capacity) {
+                grow();
+            }
+            heap[size] = h;
+            fleet.setQueueIndex(h, size);
+            size++;
+        } else if (!raise) {
+            continue;
+        }
+        if (raise) {
+            fleet.setPriority(h, target);
+        }
+        changed++;
+        
+        // Priorities only go up in urgency, so sifting up is enough
+        if (!bulk) {
+            heapifyUp(fleet.getQueueIndex(h));
+        }
     }
     
-    return true;
+    if (bulk && changed > 0) {
+        rebuild();
+    }
+    return changed;
 }
 
 void MinHeap::printHeap() const {
@@ -175,20 +304,22 @@ cout << "Queue is empty.\n";
         return;
     }
     
-cout << "Next to land: " << heap[0]->getFlightID() 
-              << " (Priority: " << heap[0]->getPriorityString() << ")\n";
+    Aircraft* top = fleet.getAircraft(heap[0]);
+cout << "Next to land: " << top->getFlightID() 
+              << " (Priority: " << top->getPriorityString() << ")\n";
 cout << "\nAll aircraft in queue:\n";
     for (int i = 0; i < size; i++) {
-cout << (i + 1) << ". " << heap[i]->getFlightID() 
-                  << " - Priority: " << heap[i]->getPriorityString()
-                  << ", Fuel: " << heap[i]->getFuelLevel() << "%\n";
+        Aircraft* ac = fleet.getAircraft(heap[i]);
+cout << (i + 1) << ". " << ac->getFlightID() 
+                  << " - Priority: " << ac->getPriorityString()
+                  << ", Fuel: " << ac->getFuelLevel() << "%\n";
     }
 }
 
 void MinHeap::clear() {
-    size = 0;
-    for (int i = 0; i < capacity; i++) {
-        heap[i] = nullptr;
+    for (int i = 0; i < size; i++) {
+        fleet.setQueueIndex(heap[i], -1);
     }
+    size = 0;
 }
 
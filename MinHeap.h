@@ -2,12 +2,15 @@
 #define MINHEAP_H
 
 #include "Aircraft.h"
+#include "LandingQueue.h"
 
 // Min-Heap for landing priority (lower priority number = higher urgency)
-class MinHeap {
+class MinHeap : public LandingQueue {
 private:
-    Aircraft** heap;  // Array of aircraft pointers
-    int* heapIndices;  // Maps aircraft to heap position (for DecreaseKey)
+    AircraftHandle* heap;  // Fleet handles; priorities are read from the fleet arrays
+    // Heap position of each aircraft is kept in the fleet's queueIndex array
+    // and updated on every swap, so lookups by aircraft are O(1)
+    FleetStore& fleet;
     int capacity;
     int size;
     
@@ -17,30 +20,46 @@ private:
     int parent(int index) { return (index - 1) / 2; }
     int leftChild(int index) { return 2 * index + 1; }
     int rightChild(int index) { return 2 * index + 2; }
+    int priorityAt(int index) const { return fleet.getPriority(heap[index]); }
     void swap(int i, int j);
+    void grow();
+    void rebuild();  // Floyd heap construction, O(n)
     
 public:
-    MinHeap(int cap = 100);
-    ~MinHeap();
+    MinHeap(int cap = 100);  // Initial capacity; grows as aircraft are added
+    ~MinHeap() override;
     
     // Core operations
-    bool insert(Aircraft* aircraft);
-    Aircraft* extractMin();  // Remove and return highest priority aircraft
-    bool isEmpty() const { return size == 0; }
-    int getSize() const { return size; }
+    bool insert(Aircraft* aircraft) override;
+    Aircraft* extractMin() override;  // Remove and return highest priority aircraft
+    bool remove(Aircraft* aircraft) override;  // O(log n) via the stored heap position
+    bool isEmpty() const override { return size == 0; }
+    int getSize() const override { return size; }
+    int getDepth() const override;
+    int getCapacity() const { return capacity; }
     
-    // Priority update
-    bool decreaseKey(const char* flightID, Priority newPriority);
-    bool updatePriority(const char* flightID, Priority newPriority);
+    // Priority update, O(log n) using the aircraft's stored heap position
+    bool decreaseKey(Aircraft* aircraft, Priority newPriority) override;
+    bool updatePriority(Aircraft* aircraft, Priority newPriority) override;
+    
+    // Priority update by flight ID (registry lookup, or a scan without one)
+    bool decreaseKey(const char* flightID, Priority newPriority) override;
+    bool updatePriority(const char* flightID, Priority newPriority) override;
+    
+    // Raises the whole batch, then restores the heap once (bottom-up
+    // rebuild for large batches, sift-up per aircraft for small ones)
+    int escalateBatch(const AircraftHandle* handles, int count, Priority newPriority) override;
     
     // Access
-    Aircraft* peek() const;  // View top without removing
-    bool contains(const char* flightID) const;
+    Aircraft* peek() const override;  // View top without removing
+    bool contains(const Aircraft* aircraft) const override;
+    bool contains(const char* flightID) const override;
+    int findIndex(const Aircraft* aircraft) const;
     int findIndex(const char* flightID) const;
     
     // Utility
-    void printHeap() const;
-    void clear();
+    void printHeap() const override;
+    void clear() override;
 };
 
 #endif // MINHEAP_H
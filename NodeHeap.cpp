@@ -0,0 +1,140 @@
+#include "NodeHeap.h"
+
+NodeHeap::NodeHeap(int cap) : capacity(cap), size(0) {
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    heap = new int[capacity];
+    positions = new int[capacity];
+    keys = new double[capacity];
+    for (int i = 0; i < capacity; i++) {
+        positions[i] = -1;
+    }
+}
+
+NodeHeap::~NodeHeap() {
+    delete[] heap;
+    delete[] positions;
+    delete[] keys;
+}
+
+void NodeHeap::reset(int nodeCount) {
+    if (nodeCount > capacity) {
+        // Grow to fit the graph; old contents are discarded
+        int newCapacity = capacity;
+        while (newCapacity < nodeCount) {
+            newCapacity *= 2;
+        }
+
+        delete[] heap;
+        delete[] positions;
+        delete[] keys;
+
+        capacity = newCapacity;
+        heap = new int[capacity];
+        positions = new int[capacity];
+        keys = new double[capacity];
+        for (int i = 0; i < capacity; i++) {
+            positions[i] = -1;
+        }
+        size = 0;
+        return;
+    }
+
+    // Only nodes still in the heap have a position set
+    for (int i = 0; i < size; i++) {
+        positions[heap[i]] = -1;
+    }
+    size = 0;
+}
+
+bool NodeHeap::less(int nodeA, int nodeB) const {
+    // Ties are broken by node ID so the settle order is deterministic
+    if (keys[nodeA] != keys[nodeB]) {
+        return keys[nodeA] < keys[nodeB];
+    }
+    return nodeA < nodeB;
+}
+
+void NodeHeap::swap(int i, int j) {
+    int temp = heap[i];
+    heap[i] = heap[j];
+    heap[j] = temp;
+
+    positions[heap[i]] = i;
+    positions[heap[j]] = j;
+}
+
+void NodeHeap::heapifyUp(int index) {
+    while (index > 0) {
+        int parentIdx = (index - 1) / 2;
+        if (less(heap[index], heap[parentIdx])) {
+            swap(index, parentIdx);
+            index = parentIdx;
+        } else {
+            break;
+        }
+    }
+}
+
+void NodeHeap::heapifyDown(int index) {
+    while (true) {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = 2 * index + 2;
+
+        if (left < size && less(heap[left], heap[smallest])) {
+            smallest = left;
+        }
+        if (right < size && less(heap[right], heap[smallest])) {
+            smallest = right;
+        }
+
+        if (smallest != index) {
+            swap(index, smallest);
+            index = smallest;
+        } else {
+            break;
+        }
+    }
+}
+
+void NodeHeap::pushOrDecrease(int nodeID, double key) {
+    if (nodeID < 0 || nodeID >= capacity) {
+        return;
+    }
+
+    int index = positions[nodeID];
+    if (index == -1) {
+        keys[nodeID] = key;
+        heap[size] = nodeID;
+        positions[nodeID] = size;
+        size++;
+        heapifyUp(size - 1);
+    } else if (key < keys[nodeID]) {
+        keys[nodeID] = key;
+        heapifyUp(index);
+    }
+}
+
+int NodeHeap::extractMin() {
+    if (size == 0) {
+        return -1;
+    }
+
+    int minNode = heap[0];
+    size--;
+    if (size > 0) {
+        heap[0] = heap[size];
+        positions[heap[0]] = 0;
+        heapifyDown(0);
+    }
+    positions[minNode] = -1;
+
+    return minNode;
+}
+
+bool NodeHeap::contains(int nodeID) const {
+    return nodeID >= 0 && nodeID < capacity && positions[nodeID] != -1;
+}
+
@@ -0,0 +1,37 @@
+#ifndef NODEHEAP_H
+#define NODEHEAP_H
+
+// Indexed binary min-heap of graph node IDs keyed by distance.
+// Used by the route searches in Graph; supports decrease-key in O(log V).
+class NodeHeap {
+private:
+    int* heap;        // Node IDs in heap order
+    int* positions;   // Maps node ID to heap slot (-1 if not in heap)
+    double* keys;     // Current key of each node ID
+    int capacity;     // Largest node ID + 1 that can be stored
+    int size;
+
+    // Helper functions
+    bool less(int nodeA, int nodeB) const;
+    void heapifyUp(int index);
+    void heapifyDown(int index);
+    void swap(int i, int j);
+
+public:
+    NodeHeap(int cap = 100);
+    ~NodeHeap();
+
+    // Empty the heap and make room for node IDs in [0, nodeCount)
+    void reset(int nodeCount);
+
+    // Core operations
+    void pushOrDecrease(int nodeID, double key);  // Insert, or lower an existing key
+    int extractMin();  // Remove and return node with the smallest key (-1 if empty)
+
+    bool isEmpty() const { return size == 0; }
+    int getSize() const { return size; }
+    bool contains(int nodeID) const;
+};
+
+#endif // NODEHEAP_H
+
@@ -0,0 +1,211 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <new>
+#include <cstring>
+
+// Allocation counters shared by the pools below
+struct PoolStats {
+    long long created;       // Objects/strings handed out
+    long long released;      // Objects returned with destroy()
+    long long slabAllocs;    // Calls to the global allocator
+    int slabCount;           // Slabs currently held
+    int live;                // Objects currently handed out
+
+    PoolStats() : created(0), released(0), slabAllocs(0), slabCount(0), live(0) {}
+};
+
+// Typed slab allocator for fixed-size nodes.
+// Objects are carved out of slabs of SLAB_SIZE slots; destroy() puts a slot
+// on a free list for reuse, and reset() releases every object at once by
+// rewinding to the first slab. Slabs are only returned to the global
+// allocator by the destructor, so a warmed-up pool never calls new.
+//
+// reset() does not run destructors: only pool trivially destructible
+// types, or types whose resources also live in pools.
+template <typename T, int SLAB_SIZE = 256>
+class ObjectPool {
+private:
+    union Slot {
+        Slot* next;  // Free-list link while the slot is unused
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    Slot** slabs;
+    int slabCapacity;
+    int slabCount;   // Slabs allocated
+    int activeSlab;  // Slab currently being carved
+    int carved;      // Slots used in the active slab
+    Slot* freeList;
+    PoolStats stats;
+
+    Slot* takeSlot() {
+        if (freeList != nullptr) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        if (carved == SLAB_SIZE || slabCount == 0) {
+            activeSlab = slabCount == 0 ? 0 : activeSlab + 1;
+            carved = 0;
+            if (activeSlab == slabCount) {
+                addSlab();
+            }
+        }
+        return &slabs[activeSlab][carved++];
+    }
+
+    void addSlab() {
+        if (slabCount == slabCapacity) {
+            int newCapacity = slabCapacity * 2;
+            Slot** newSlabs = new Slot*[newCapacity];
+            for (int i = 0; i < slabCount; i++) {
+                newSlabs[i] = slabs[i];
+            }
+            delete[] slabs;
+            slabs = newSlabs;
+            slabCapacity = newCapacity;
+            stats.slabAllocs++;
+        }
+        slabs[slabCount++] = new Slot[SLAB_SIZE];
+        stats.slabAllocs++;
+        stats.slabCount = slabCount;
+    }
+
+    ObjectPool(const ObjectPool&);
+    ObjectPool& operator=(const ObjectPool&);
+
+public:
+    ObjectPool() : slabCapacity(4), slabCount(0), activeSlab(0), carved(0), freeList(nullptr) {
+        slabs = new Slot*[slabCapacity];
+    }
+
+    ~ObjectPool() {
+        for (int i = 0; i < slabCount; i++) {
+            delete[] slabs[i];
+        }
+        delete[] slabs;
+    }
+
+    template <typename... Args>
+    T* create(Args... args) {
+        Slot* slot = takeSlot();
+        stats.created++;
+        stats.live++;
+        return new (slot->storage) T(args...);
+    }
+
+    void destroy(T* object) {
+        if (object == nullptr) {
+            return;
+        }
+        object->~T();
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = freeList;
+        freeList = slot;
+        stats.released++;
+        stats.live--;
+    }
+
+    // Release every object in O(1); slabs are kept for reuse
+    void reset() {
+        activeSlab = 0;
+        carved = 0;
+        freeList = nullptr;
+        stats.live = 0;
+    }
+
+    int getLiveCount() const { return stats.live; }
+    int getCapacity() const { return slabCount * SLAB_SIZE; }
+    const PoolStats& getStats() const { return stats; }
+};
+
+// Bump allocator for strings that are freed all together (node names).
+// Strings are copied into large blocks; reset() rewinds to the first block.
+class StringArena {
+private:
+    static const int BLOCK_SIZE = 4096;
+
+    char** blocks;
+    int* blockSizes;
+    int blockCapacity;
+    int blockCount;
+    int activeBlock;
+    int used;        // Bytes used in the active block
+    PoolStats stats;
+
+    void nextBlock(int minSize) {
+        // Skip kept blocks too small for this string, else add one
+        activeBlock = blockCount == 0 ? 0 : activeBlock + 1;
+        while (activeBlock < blockCount && blockSizes[activeBlock] < minSize) {
+            activeBlock++;
+        }
+        used = 0;
+        if (activeBlock < blockCount) {
+            return;
+        }
+
+        if (blockCount == blockCapacity) {
+            int newCapacity = blockCapacity * 2;
+            char** newBlocks = new char*[newCapacity];
+            int* newSizes = new int[newCapacity];
+            for (int i = 0; i < blockCount; i++) {
+                newBlocks[i] = blocks[i];
+                newSizes[i] = blockSizes[i];
+            }
+            delete[] blocks;
+            delete[] blockSizes;
+            blocks = newBlocks;
+            blockSizes = newSizes;
+            blockCapacity = newCapacity;
+            stats.slabAllocs += 2;
+        }
+        int size = minSize > BLOCK_SIZE ? minSize : BLOCK_SIZE;
+        blocks[blockCount] = new char[size];
+        blockSizes[blockCount] = size;
+        blockCount++;
+        stats.slabAllocs++;
+        stats.slabCount = blockCount;
+    }
+
+    StringArena(const StringArena&);
+    StringArena& operator=(const StringArena&);
+
+public:
+    StringArena() : blockCapacity(4), blockCount(0), activeBlock(0), used(0) {
+        blocks = new char*[blockCapacity];
+        blockSizes = new int[blockCapacity];
+    }
+
+    ~StringArena() {
+        for (int i = 0; i < blockCount; i++) {
+            delete[] blocks[i];
+        }
+        delete[] blocks;
+        delete[] blockSizes;
+    }
+
+    char* copy(const char* text) {
+        int length = int(strlen(text)) + 1;
+        if (blockCount == 0 || activeBlock >= blockCount || used + length > blockSizes[activeBlock]) {
+            nextBlock(length);
+        }
+        char* result = blocks[activeBlock] + used;
+        memcpy(result, text, length);
+        used += length;
+        stats.created++;
+        stats.live++;
+        return result;
+    }
+
+    void reset() {
+        activeBlock = 0;
+        used = 0;
+        stats.live = 0;
+    }
+
+    const PoolStats& getStats() const { return stats; }
+};
+
+#endif // POOL_H
+
@@ -1,9 +1,11 @@
 #include "Radar.h"
+#include "Aircraft.h"
 #include <iostream>
+#include <iomanip>
 #include <cstdlib>
 using namespace std;
 
-Radar::Radar(Graph* graph) : airspace(graph) {
+Radar::Radar(Graph* graph) : airspace(graph), conflicts(nullptr), predictor(nullptr) {
     grid = new char*[GRID_SIZE];
     for (int i = 0; i < GRID_SIZE; i++) {
         grid[i] = new char[GRID_SIZE];
@@ -53,11 +55,33 @@ void Radar::updateGrid() {
                         grid[y][x] = ' ';  // Waypoint (invisible on radar)
                     }
                 }
-                
-                // Mark aircraft
-                if (node->aircraft != nullptr) {
-                    grid[y][x] = 'P';
-                }
+            }
+        }
+    }
+    
+    // Mark aircraft straight from the fleet's position arrays
+    const FleetStore& fleet = FleetStore::shared();
+    for (int h = 0; h < fleet.getHighWater(); h++) {
+        if (!fleet.isActive(h) || fleet.hasFlag(h, FleetStore::LANDED) || fleet.getNodeID(h) == -1) {
+            continue;
+        }
+        int x = fleet.getX(h);
+        int y = fleet.getY(h);
+        if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
+            grid[y][x] = 'P';
+        }
+    }
+    
+    // Aircraft closer than the separation minimum
+    if (conflicts != nullptr && conflicts->detect() > 0) {
+        for (int h = 0; h < fleet.getHighWater(); h++) {
+            if (!conflicts->isInConflict(h)) {
+                continue;
+            }
+            int x = fleet.getX(h);
+            int y = fleet.getY(h);
+            if (x >= 0 && x < GRID_SIZE && y >= 0 && y < GRID_SIZE) {
+                grid[y][x] = 'X';
             }
         }
     }
@@ -71,7 +95,7 @@ cout << "╔══════════════════════
 cout << "║                    SKYNET RADAR VIEW                     ║\n";
 cout << "╚══════════════════════════════════════════════════════════╝\n";
 cout << "\n";
-cout << "Legend: A = Airport, P = Plane, . = Empty Sky\n";
+cout << "Legend: A = Airport, P = Plane, X = Separation Conflict, . = Empty Sky\n";
 cout << "\n";
     
     // Print column numbers
@@ -83,13 +107,57 @@ cout << "\n";
     
     // Print grid with row numbers
     for (int i = 0; i < GRID_SIZE; i++) {
-        printf("%2d ", i);
+cout << setw(2) << i << " ";
         for (int j = 0; j < GRID_SIZE; j++) {
 cout << grid[i][j];
         }
 cout << "\n";
     }
 cout << "\n";
+    
+    printConflicts();
+    printPredictions();
+}
+
+void Radar::printConflicts() {
+    if (conflicts == nullptr || conflicts->getConflictCount() == 0) {
+        return;
+    }
+    
+    // List the first few; the grid marks them all
+    const Conflict* list = conflicts->getConflicts();
+    int count = conflicts->getConflictCount();
+cout << "*** SEPARATION CONFLICTS: " << count << " (minimum "
+     << conflicts->getSeparation() << " grid units) ***\n";
+    for (int i = 0; i < count && i < MAX_LISTED; i++) {
+        Aircraft* first = Aircraft::fromHandle(list[i].first);
+        Aircraft* second = Aircraft::fromHandle(list[i].second);
+cout << "  " << first->getFlightID() << " - " << second->getFlightID()
+     << ": " << list[i].distance << " grid units\n";
+    }
+    if (count > MAX_LISTED) {
+cout << "  ... and " << (count - MAX_LISTED) << " more\n";
+    }
+}
+
+void Radar::printPredictions() {
+    if (predictor == nullptr || predictor->predict() == 0) {
+        return;
+    }
+    
+    // Soonest first, as the predictor sorts them
+    const PredictedConflict* list = predictor->getPredictions();
+    int count = predictor->getPredictionCount();
+cout << "*** PREDICTED CONFLICTS (next " << predictor->getHorizon() << " min): " << count << " ***\n";
+    for (int i = 0; i < count && i < MAX_LISTED; i++) {
+        Aircraft* first = Aircraft::fromHandle(list[i].first);
+        Aircraft* second = Aircraft::fromHandle(list[i].second);
+cout << "  " << first->getFlightID() << " - " << second->getFlightID()
+     << ": " << list[i].missDistance << " grid units in " << list[i].timeToClosest << " min\n";
+    }
+    if (count > MAX_LISTED) {
+cout << "  ... and " << (count - MAX_LISTED) << " more\n";
+    }
 }
 
 void Radar::refresh() {
@@ -2,16 +2,23 @@
 #define RADAR_H
 
 #include "Graph.h"
+#include "ConflictDetector.h"
+#include "ConflictPredictor.h"
 
 // Radar visualization system (2D grid)
 class Radar {
 private:
     static const int GRID_SIZE = 20;
+    static const int MAX_LISTED = 10;  // Conflicts listed under the grid
     char** grid;
     Graph* airspace;
+    ConflictDetector* conflicts;  // Optional; marks aircraft losing separation
+    ConflictPredictor* predictor; // Optional; lists conflicts ahead
     
     void clearGrid();
     void updateGrid();
+    void printConflicts();
+    void printPredictions();
     
 public:
     Radar(Graph* graph);
@@ -19,6 +26,8 @@ public:
     
     void display();
     void refresh();  // Clear screen and redraw
+    void setConflictDetector(ConflictDetector* detector) { conflicts = detector; }
+    void setConflictPredictor(ConflictPredictor* lookAhead) { predictor = lookAhead; }
     int getGridSize() const { return GRID_SIZE; }
 };
 
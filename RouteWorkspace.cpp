@@ -0,0 +1,87 @@
+#include "RouteWorkspace.h"
+
+const double RouteWorkspace::INF = 1e9;  // Same "unreachable" value Graph has always used
+
+RoutePath::RoutePath(int cap) : length(0), capacity(cap), totalDistance(0.0) {
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    nodes = new int[capacity];
+}
+
+RoutePath::~RoutePath() {
+    delete[] nodes;
+}
+
+void RoutePath::reserve(int minCapacity) {
+    if (minCapacity <= capacity) {
+        return;
+    }
+
+    int newCapacity = capacity;
+    while (newCapacity < minCapacity) {
+        newCapacity *= 2;
+    }
+
+    // Contents are rewritten by the caller, no need to copy
+    delete[] nodes;
+    nodes = new int[newCapacity];
+    capacity = newCapacity;
+}
+
+RouteWorkspace::RouteWorkspace(int cap) : capacity(0), generation(0), heap(cap) {
+    distances = nullptr;
+    previous = nullptr;
+    touched = nullptr;
+    closed = nullptr;
+    grow(cap < 1 ? 1 : cap);
+}
+
+RouteWorkspace::~RouteWorkspace() {
+    delete[] distances;
+    delete[] previous;
+    delete[] touched;
+    delete[] closed;
+}
+
+void RouteWorkspace::grow(int nodeCount) {
+    int newCapacity = capacity > 0 ? capacity : 1;
+    while (newCapacity < nodeCount) {
+        newCapacity *= 2;
+    }
+
+    delete[] distances;
+    delete[] previous;
+    delete[] touched;
+    delete[] closed;
+
+    capacity = newCapacity;
+    distances = new double[capacity];
+    previous = new int[capacity];
+    touched = new unsigned int[capacity];
+    closed = new unsigned int[capacity];
+    for (int i = 0; i < capacity; i++) {
+        touched[i] = 0;
+        closed[i] = 0;
+    }
+    generation = 0;
+}
+
+void RouteWorkspace::begin(int nodeCount) {
+    if (nodeCount > capacity) {
+        grow(nodeCount);
+    }
+
+    generation++;
+    if (generation == 0) {
+        // Counter wrapped: old tags could alias the new generation
+        for (int i = 0; i < capacity; i++) {
+            touched[i] = 0;
+            closed[i] = 0;
+        }
+        generation = 1;
+    }
+
+    heap.reset(nodeCount);
+}
+
@@ -0,0 +1,73 @@
+#ifndef ROUTEWORKSPACE_H
+#define ROUTEWORKSPACE_H
+
+#include "NodeHeap.h"
+
+// Caller-owned route buffer filled by the allocation-free Graph searches.
+// The node array only grows, so a buffer reused across queries stops
+// allocating once it has seen the longest route.
+struct RoutePath {
+    int* nodes;           // Node IDs from start to end
+    int length;           // 0 when no route was found
+    int capacity;
+    double totalDistance;
+
+    RoutePath(int cap = 16);
+    ~RoutePath();
+
+    void reserve(int minCapacity);
+    bool found() const { return length > 0; }
+
+private:
+    RoutePath(const RoutePath&);
+    RoutePath& operator=(const RoutePath&);
+};
+
+// Scratch state for one route search, reused across queries.
+// Per-node distance/previous/closed entries are tagged with a generation
+// number, so starting a new query is O(1) instead of clearing V entries.
+class RouteWorkspace {
+private:
+    double* distances;
+    int* previous;
+    unsigned int* touched;  // Generation in which distances/previous were set
+    unsigned int* closed;   // Generation in which the node was settled
+    int capacity;
+    unsigned int generation;
+    NodeHeap heap;
+
+    void grow(int nodeCount);
+
+    RouteWorkspace(const RouteWorkspace&);
+    RouteWorkspace& operator=(const RouteWorkspace&);
+
+public:
+    static const double INF;
+
+    RouteWorkspace(int cap = 100);
+    ~RouteWorkspace();
+
+    // Start a new query over node IDs in [0, nodeCount)
+    void begin(int nodeCount);
+
+    double getDistance(int nodeID) const {
+        return touched[nodeID] == generation ? distances[nodeID] : INF;
+    }
+    int getPrevious(int nodeID) const {
+        return touched[nodeID] == generation ? previous[nodeID] : -1;
+    }
+    void setDistance(int nodeID, double distance, int prev) {
+        distances[nodeID] = distance;
+        previous[nodeID] = prev;
+        touched[nodeID] = generation;
+    }
+
+    bool isClosed(int nodeID) const { return closed[nodeID] == generation; }
+    void close(int nodeID) { closed[nodeID] = generation; }
+
+    NodeHeap& getHeap() { return heap; }
+    int getCapacity() const { return capacity; }
+};
+
+#endif // ROUTEWORKSPACE_H
+
@@ -0,0 +1,285 @@
+#include "ScriptRunner.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+using namespace std;
+
+const char* const ScriptRunner::COMMAND_NAMES[COMMAND_COUNT] = {
+    "add", "move", "emergency", "land", "search", "route",
+    "advance", "simulate", "forecast", "save", "load", "airspace",
+    "stats"
+};
+
+const char* const ScriptRunner::COMMAND_USAGE[COMMAND_COUNT] = {
+    "add <id> <model> <origin> <dest> <fuel> <type 1-4> [priority 1-4]",
+    "move <id> <node>",
+    "emergency <id>",
+    "land",
+    "search <id>",
+    "route <id>",
+    "advance <minutes>",
+    "simulate <ticks>",
+    "forecast",
+    "save",
+    "load",
+    "airspace grid|random <width|nodes> <height|corridors> <seed>",
+    "stats [json-file]"
+};
+
+static int compareMicros(const void* a, const void* b) {
+    double x = *static_cast<const double*>(a);
+    double y = *static_cast<const double*>(b);
+    return (x > y) - (x < y);
+}
+
+ScriptRunner::ScriptRunner(SkyNet& system, bool echo)
+    : skynet(system), echoOutput(echo), latencyCount(0), latencyCapacity(256),
+      okCount(0), failedCount(0), invalidCount(0), wallSeconds(0.0) {
+    latencies = new double[latencyCapacity];
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        commandRuns[i] = 0;
+        commandFailures[i] = 0;
+        commandMicros[i] = 0.0;
+    }
+}
+
+ScriptRunner::~ScriptRunner() {
+    delete[] latencies;
+}
+
+int ScriptRunner::findCommand(const char* name) {
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        if (strcmp(COMMAND_NAMES[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void ScriptRunner::recordLatency(double micros) {
+    if (latencyCount >= latencyCapacity) {
+        int newCapacity = latencyCapacity * 2;
+        double* newLatencies = new double[newCapacity];
+        for (int i = 0; i < latencyCount; i++) {
+            newLatencies[i] = latencies[i];
+        }
+        delete[] latencies;
+        latencies = newLatencies;
+        latencyCapacity = newCapacity;
+    }
+    latencies[latencyCount++] = micros;
+}
+
+bool ScriptRunner::parseAndRun(int command, istream& args, ostream& out, bool& parsed) {
+    FlightId flightID;
+    parsed = true;
+    
+    switch (command) {
+        case 0: {
+            char model[100], origin[100], dest[100];
+            double fuel;
+            int type;
+            if (!(args >> flightID >> setw(100) >> model >> setw(100) >> origin
+                      >> setw(100) >> dest >> fuel >> type)) {
+                break;
+            }
+            int priority;
+            if (!(args >> priority)) {
+                priority = 0;  // Usual priority for the type
+            }
+            return skynet.addFlight(flightID, model, origin, dest, fuel, type, out, priority);
+        }
+        case 1: {
+            int node;
+            if (!(args >> flightID >> node)) {
+                break;
+            }
+            return skynet.moveAircraft(flightID, node, out);
+        }
+        case 2:
+            if (!(args >> flightID)) {
+                break;
+            }
+            return skynet.declareEmergency(flightID, out);
+        case 3:
+            return skynet.landFlight(out);
+        case 4:
+            if (!(args >> flightID)) {
+                break;
+            }
+            return skynet.searchFlight(flightID, out);
+        case 5:
+            if (!(args >> flightID)) {
+                break;
+            }
+            return skynet.findSafeRoute(flightID, out);
+        case 6: {
+            double minutes;
+            if (!(args >> minutes)) {
+                break;
+            }
+            return skynet.advanceTime(minutes, out);
+        }
+        case 7: {
+            int ticks;
+            if (!(args >> ticks)) {
+                break;
+            }
+            return skynet.runSimulation(ticks, out);
+        }
+        case 8:
+            return skynet.printConflictForecast(out);
+        case 9:
+            return skynet.saveState(out);
+        case 10:
+            return skynet.loadState(out);
+        case 11: {
+            char kind[16];
+            int a, b;
+            unsigned long long seed;
+            if (!(args >> setw(16) >> kind >> a >> b >> seed)) {
+                break;
+            }
+            return skynet.generateAirspace(kind, a, b, seed, out);
+        }
+        case 12: {
+            string path;
+            if (args >> path) {
+                return skynet.writeMetrics(path.c_str(), out);
+            }
+            return skynet.printMetrics(out);
+        }
+    }
+    
+    parsed = false;
+    return false;
+}
+
+bool ScriptRunner::runFile(const char* path) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        cout << "Error: Could not open script " << path << "\n";
+        return false;
+    }
+    run(file);
+    return true;
+}
+
+void ScriptRunner::run(istream& script) {
+    chrono::steady_clock::time_point runStart = chrono::steady_clock::now();
+    
+    string line;
+    int lineNumber = 0;
+    while (getline(script, line)) {
+        lineNumber++;
+        
+        // Tolerate CRLF scripts and indentation
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        size_t first = line.find_first_not_of(" \t");
+        if (first == string::npos || line[first] == '#') {
+            continue;
+        }
+        line = line.substr(first);
+        
+        istringstream args(line);
+        string name;
+        args >> name;
+        int command = findCommand(name.c_str());
+        if (command == -1) {
+            invalidCount++;
+            cout << "[" << lineNumber << "] " << line << " -> INVALID (unknown command)\n";
+            continue;
+        }
+        
+        // Output is captured so timing covers the operation, not the console
+        ostringstream output;
+        bool parsed;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        bool ok = parseAndRun(command, args, output, parsed);
+        double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        
+        if (!parsed) {
+            invalidCount++;
+            cout << "[" << lineNumber << "] " << line << " -> INVALID (usage: "
+                 << COMMAND_USAGE[command] << ")\n";
+            continue;
+        }
+        
+        recordLatency(micros);
+        commandRuns[command]++;
+        commandMicros[command] += micros;
+        if (ok) {
+            okCount++;
+        } else {
+            failedCount++;
+            commandFailures[command]++;
+        }
+        
+        char elapsed[32];
+        snprintf(elapsed, sizeof(elapsed), "%.1f", micros);
+        cout << "[" << lineNumber << "] " << line << " -> " << (ok ? "OK" : "FAILED")
+             << " (" << elapsed << " us)\n";
+        
+        if (echoOutput) {
+            istringstream captured(output.str());
+            string outputLine;
+            while (getline(captured, outputLine)) {
+                if (!outputLine.empty()) {
+                    cout << "    " << outputLine << "\n";
+                }
+            }
+        }
+    }
+    
+    wallSeconds += chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+}
+
+void ScriptRunner::printSummary() const {
+    int executed = okCount + failedCount;
+    
+    cout << "\n=== Script Summary ===\n";
+    cout << "Commands: " << executed << " executed (" << okCount << " ok, "
+         << failedCount << " failed), " << invalidCount << " invalid\n";
+    cout << "Wall time: " << wallSeconds * 1000.0 << " ms\n";
+    if (executed == 0) {
+        return;
+    }
+    if (wallSeconds > 0.0) {
+        cout << "Throughput: " << long(executed / wallSeconds) << " commands/s\n";
+    }
+    
+    // Percentiles from a sorted copy of the samples
+    double* sorted = new double[latencyCount];
+    double total = 0.0;
+    for (int i = 0; i < latencyCount; i++) {
+        sorted[i] = latencies[i];
+        total += latencies[i];
+    }
+    qsort(sorted, latencyCount, sizeof(double), compareMicros);
+    
+    cout << "Latency (us): min " << sorted[0]
+         << ", mean " << total / latencyCount
+         << ", p50 " << sorted[(latencyCount - 1) / 2]
+         << ", p99 " << sorted[(latencyCount - 1) * 99 / 100]
+         << ", max " << sorted[latencyCount - 1] << "\n";
+    delete[] sorted;
+    
+    cout << "Per command:\n";
+    for (int i = 0; i < COMMAND_COUNT; i++) {
+        if (commandRuns[i] == 0) {
+            continue;
+        }
+        cout << "  " << left << setw(10) << COMMAND_NAMES[i] << right
+             << setw(8) << commandRuns[i] << " runs, "
+             << setw(4) << commandFailures[i] << " failed, mean "
+             << commandMicros[i] / commandRuns[i] << " us\n";
+    }
+}
+
@@ -0,0 +1,65 @@
+#ifndef SCRIPTRUNNER_H
+#define SCRIPTRUNNER_H
+
+#include "SkyNet.h"
+#include <iostream>
+using namespace std;
+
+// Headless batch mode: runs a stream of operator commands against SkyNet's
+// core operations back to back (no prompts, pauses or screen clearing),
+// prints one result line per command and a throughput/latency summary.
+//
+// One command per line; blank lines and lines starting with '#' are skipped:
+//   add <id> <model> <origin> <dest> <fuel> <type 1-4> [priority 1-4]
+//   move <id> <node>        emergency <id>        land
+//   search <id>             route <id>            forecast
+//   advance <minutes>       simulate <ticks>      save        load
+//   airspace grid <width> <height> <seed>
+//   airspace random <nodes> <corridors> <seed>
+//   stats [json-file]       latency histograms and gauges (or write them as JSON)
+class ScriptRunner {
+private:
+    static const int COMMAND_COUNT = 13;
+    static const char* const COMMAND_NAMES[COMMAND_COUNT];
+    static const char* const COMMAND_USAGE[COMMAND_COUNT];
+    
+    SkyNet& skynet;
+    bool echoOutput;  // Print each command's own output under its result line
+    
+    // Latency of every executed command, microseconds
+    double* latencies;
+    int latencyCount;
+    int latencyCapacity;
+    
+    int okCount;
+    int failedCount;
+    int invalidCount;  // Unknown commands and bad arguments (not executed)
+    double wallSeconds;
+    
+    // Per-command totals, indexed like COMMAND_NAMES
+    int commandRuns[COMMAND_COUNT];
+    int commandFailures[COMMAND_COUNT];
+    double commandMicros[COMMAND_COUNT];
+    
+    static int findCommand(const char* name);
+    bool parseAndRun(int command, istream& args, ostream& out, bool& parsed);
+    void recordLatency(double micros);
+    
+    ScriptRunner(const ScriptRunner&);
+    ScriptRunner& operator=(const ScriptRunner&);
+    
+public:
+    ScriptRunner(SkyNet& system, bool echo = true);
+    ~ScriptRunner();
+    
+    bool runFile(const char* path);  // false if the file cannot be opened
+    void run(istream& script);
+    void printSummary() const;
+    
+    int getOkCount() const { return okCount; }
+    int getFailedCount() const { return failedCount; }
+    int getInvalidCount() const { return invalidCount; }
+};
+
+#endif // SCRIPTRUNNER_H
+
@@ -0,0 +1,497 @@
+#include "SimulationEngine.h"
+#include <cstring>
+using namespace std;
+
+SimulationEngine::SimulationEngine(Graph& graph, LandingQueue& queue, HashTable& aircraftRegistry,
+                                   FlightLog& logs, double tickLength, double speed)
+    : airspace(graph), landingQueue(queue), registry(aircraftRegistry), flightLogs(logs),
+      fleet(FleetStore::shared()), slotCapacity(0), active(nullptr), activeCount(0),
+      activeCapacity(0), tickMinutes(tickLength), cruiseSpeed(speed), lowFuelThreshold(10.0),
+      imminentWindow(2.0), clock(0.0), tickCount(0), landedCount(0), holdCount(0),
+      conflictCount(0), lastConflicts(0), yieldCount(0) {
+    workspace = new RouteWorkspace(graph.getMaxNodes());
+    scratchPath = new RoutePath();
+    conflicts = nullptr;
+    predictor = nullptr;
+    
+    planNodes = nullptr;
+    planCapacity = nullptr;
+    planLength = nullptr;
+    planLeg = nullptr;
+    legLength = nullptr;
+    legFlown = nullptr;
+    activeIndex = nullptr;
+    yielding = nullptr;
+    ensureSlots(fleet.getCapacity() > 0 ? fleet.getCapacity() - 1 : 0);
+}
+
+SimulationEngine::~SimulationEngine() {
+    // Aircraft belong to the caller; only plan state is freed here
+    for (int i = 0; i < slotCapacity; i++) {
+        delete[] planNodes[i];
+    }
+    delete[] planNodes;
+    delete[] planCapacity;
+    delete[] planLength;
+    delete[] planLeg;
+    delete[] legLength;
+    delete[] legFlown;
+    delete[] activeIndex;
+    delete[] yielding;
+    delete[] active;
+    delete scratchPath;
+    delete workspace;
+}
+
+void SimulationEngine::ensureSlots(AircraftHandle h) {
+    if (int(h) < slotCapacity) {
+        return;
+    }
+    
+    int newCapacity = slotCapacity > 0 ? slotCapacity * 2 : 16;
+    while (newCapacity <= int(h)) {
+        newCapacity *= 2;
+    }
+    
+    int** newPlanNodes = new int*[newCapacity];
+    int* newPlanCapacity = new int[newCapacity];
+    int* newPlanLength = new int[newCapacity];
+    int* newPlanLeg = new int[newCapacity];
+    double* newLegLength = new double[newCapacity];
+    double* newLegFlown = new double[newCapacity];
+    int* newActiveIndex = new int[newCapacity];
+    unsigned char* newYielding = new unsigned char[newCapacity];
+    
+    for (int i = 0; i < newCapacity; i++) {
+        if (i < slotCapacity) {
+            newPlanNodes[i] = planNodes[i];
+            newPlanCapacity[i] = planCapacity[i];
+            newPlanLength[i] = planLength[i];
+            newPlanLeg[i] = planLeg[i];
+            newLegLength[i] = legLength[i];
+            newLegFlown[i] = legFlown[i];
+            newActiveIndex[i] = activeIndex[i];
+            newYielding[i] = yielding[i];
+        } else {
+            newPlanNodes[i] = nullptr;
+            newPlanCapacity[i] = 0;
+            newPlanLength[i] = 0;
+            newPlanLeg[i] = 0;
+            newLegLength[i] = 0.0;
+            newLegFlown[i] = 0.0;
+            newActiveIndex[i] = -1;
+            newYielding[i] = 0;
+        }
+    }
+    
+    delete[] planNodes;
+    delete[] planCapacity;
+    delete[] planLength;
+    delete[] planLeg;
+    delete[] legLength;
+    delete[] legFlown;
+    delete[] activeIndex;
+    delete[] yielding;
+    
+    planNodes = newPlanNodes;
+    planCapacity = newPlanCapacity;
+    planLength = newPlanLength;
+    planLeg = newPlanLeg;
+    legLength = newLegLength;
+    legFlown = newLegFlown;
+    activeIndex = newActiveIndex;
+    yielding = newYielding;
+    slotCapacity = newCapacity;
+}
+
+bool SimulationEngine::startPlan(AircraftHandle h, const RoutePath& path) {
+    ensureSlots(h);
+    
+    if (planCapacity[h] < path.length) {
+        delete[] planNodes[h];
+        planNodes[h] = new int[path.length];
+        planCapacity[h] = path.length;
+    }
+    for (int i = 0; i < path.length; i++) {
+        planNodes[h][i] = path.nodes[i];
+    }
+    planLength[h] = path.length;
+    planLeg[h] = 0;
+    legFlown[h] = 0.0;
+    
+    if (activeIndex[h] == -1) {
+        if (activeCount >= activeCapacity) {
+            int newCapacity = activeCapacity > 0 ? activeCapacity * 2 : 16;
+            AircraftHandle* newActive = new AircraftHandle[newCapacity];
+            for (int i = 0; i < activeCount; i++) {
+                newActive[i] = active[i];
+            }
+            delete[] active;
+            active = newActive;
+            activeCapacity = newCapacity;
+        }
+        activeIndex[h] = activeCount;
+        active[activeCount++] = h;
+    }
+    
+    beginLeg(h);
+    return true;
+}
+
+void SimulationEngine::beginLeg(AircraftHandle h) {
+    int leg = planLeg[h];
+    if (leg < planLength[h] - 1) {
+        // -1 if the corridor was removed after planning; advance() re-plans
+        legLength[h] = airspace.getEdgeWeight(planNodes[h][leg], planNodes[h][leg + 1]);
+    } else {
+        legLength[h] = 0.0;
+    }
+}
+
+bool SimulationEngine::planRoute(Aircraft* aircraft, int destinationNode) {
+    if (aircraft == nullptr || aircraft->getIsLanded() || !airspace.nodeExists(destinationNode)) {
+        return false;
+    }
+    
+    int current = aircraft->getCurrentNodeID();
+    if (!airspace.nodeExists(current)) {
+        return false;
+    }
+    
+    if (!airspace.findShortestPath(current, destinationNode, RouteAlgorithm::ASTAR,
+                                   *workspace, *scratchPath)) {
+        return false;
+    }
+    return startPlan(aircraft->getHandle(), *scratchPath);
+}
+
+bool SimulationEngine::planToDestination(Aircraft* aircraft) {
+    if (aircraft == nullptr || aircraft->getIsLanded()) {
+        return false;
+    }
+    
+    // Filed destination first, if it names an airport in this airspace
+    int destination = airspace.findNodeByName(aircraft->getDestination());
+    if (destination != -1 && airspace.getNode(destination)->isAirport &&
+        planRoute(aircraft, destination)) {
+        return true;
+    }
+    
+    int current = aircraft->getCurrentNodeID();
+    if (!airspace.nodeExists(current) ||
+        !airspace.findShortestPathToNearestAirport(current, *workspace, *scratchPath)) {
+        return false;
+    }
+    return startPlan(aircraft->getHandle(), *scratchPath);
+}
+
+int SimulationEngine::planAll() {
+    int count;
+    Aircraft** all = registry.getAllAircraft(count);
+    
+    int planned = 0;
+    for (int i = 0; i < count; i++) {
+        Aircraft* aircraft = all[i];
+        if (aircraft->getIsLanded() || aircraft->getCurrentNodeID() == -1 || hasPlan(aircraft)) {
+            continue;
+        }
+        if (planToDestination(aircraft)) {
+            planned++;
+        }
+    }
+    
+    delete[] all;
+    return planned;
+}
+
+void SimulationEngine::cancel(Aircraft* aircraft) {
+    if (aircraft == nullptr) {
+        return;
+    }
+    
+    AircraftHandle h = aircraft->getHandle();
+    if (int(h) >= slotCapacity || activeIndex[h] == -1) {
+        return;
+    }
+    
+    // Swap-remove from the dense list
+    int index = activeIndex[h];
+    AircraftHandle last = active[activeCount - 1];
+    active[index] = last;
+    activeIndex[last] = index;
+    activeCount--;
+    
+    activeIndex[h] = -1;
+    planLength[h] = 0;
+    fleet.setVelocity(h, 0.0f, 0.0f);
+}
+
+bool SimulationEngine::spawnFlight(Aircraft* aircraft, int originNode, int destinationNode) {
+    // An ID too long to key the registry is empty; it could never be found again
+    if (aircraft == nullptr || aircraft->getFlightId().isEmpty() ||
+        airspace.isNodeOccupied(originNode) ||
+        registry.search(aircraft->getFlightId()) != nullptr) {
+        return false;
+    }
+    if (!airspace.placeAircraft(originNode, aircraft)) {
+        return false;
+    }
+    if (!planRoute(aircraft, destinationNode)) {
+        airspace.removeAircraft(originNode);
+        return false;
+    }
+    
+    registry.insert(aircraft->getFlightId(), aircraft);
+    landingQueue.insert(aircraft);
+    return true;
+}
+
+bool SimulationEngine::hasPlan(const Aircraft* aircraft) const {
+    if (aircraft == nullptr) {
+        return false;
+    }
+    AircraftHandle h = aircraft->getHandle();
+    return int(h) < slotCapacity && activeIndex[h] != -1;
+}
+
+void SimulationEngine::land(AircraftHandle h) {
+    Aircraft* aircraft = fleet.getAircraft(h);
+    int airport = planNodes[h][planLength[h] - 1];
+    GraphNode* node = airspace.getNode(airport);
+    
+    // Still holding a node if the plan started at the airport
+    GraphNode* current = airspace.getNode(fleet.getNodeID(h));
+    if (current != nullptr && current->occupant == h) {
+        airspace.removeAircraft(current->nodeID);
+    }
+    
+    cancel(aircraft);
+    landingQueue.remove(aircraft);
+    aircraft->setCurrentNodeID(airport);
+    aircraft->setPosition(node->gridX, node->gridY);
+    aircraft->setLanded(true);
+    
+    // Same hand-off as a manual landing: log it, then release the aircraft
+    flightLogs.insert(aircraft, aircraft->getArrivalTimestamp());
+    registry.remove(aircraft->getFlightId());
+    landedCount++;
+    delete aircraft;
+}
+
+bool SimulationEngine::isWaitingFor(AircraftHandle other, int nodeID) const {
+    if (int(other) >= slotCapacity || activeIndex[other] == -1) {
+        return false;
+    }
+    int leg = planLeg[other];
+    return leg < planLength[other] - 1 && planNodes[other][leg + 1] == nodeID &&
+           legLength[other] >= 0.0 && legFlown[other] >= legLength[other];
+}
+
+void SimulationEngine::passHeadOn(AircraftHandle h, AircraftHandle other) {
+    int here = planNodes[h][planLeg[h]];
+    int there = planNodes[other][planLeg[other]];
+    airspace.removeAircraft(here);
+    airspace.removeAircraft(there);
+    airspace.placeAircraft(there, fleet.getAircraft(h));
+    airspace.placeAircraft(here, fleet.getAircraft(other));
+    
+    legFlown[h] -= legLength[h];
+    planLeg[h]++;
+    beginLeg(h);
+    
+    legFlown[other] -= legLength[other];
+    planLeg[other]++;
+    beginLeg(other);
+    if (planLeg[other] < planLength[other] - 1 && legLength[other] >= 0.0) {
+        interpolate(other);
+    }
+}
+
+void SimulationEngine::interpolate(AircraftHandle h) {
+    int leg = planLeg[h];
+    GraphNode* from = airspace.getNode(planNodes[h][leg]);
+    GraphNode* to = airspace.getNode(planNodes[h][leg + 1]);
+    
+    double t = legLength[h] > 0.0 ? legFlown[h] / legLength[h] : 0.0;
+    if (t > 1.0) {
+        t = 1.0;
+    }
+    fleet.setTrack(h, float(from->gridX + (to->gridX - from->gridX) * t),
+                   float(from->gridY + (to->gridY - from->gridY) * t));
+    
+    // Grid units per minute along the edge; zero while holding at its end
+    if (legLength[h] > 0.0 && legFlown[h] < legLength[h]) {
+        double scale = cruiseSpeed / legLength[h];
+        fleet.setVelocity(h, float((to->gridX - from->gridX) * scale),
+                          float((to->gridY - from->gridY) * scale));
+    } else {
+        fleet.setVelocity(h, 0.0f, 0.0f);
+    }
+}
+
+bool SimulationEngine::advance(AircraftHandle h, double distance) {
+    Aircraft* aircraft = fleet.getAircraft(h);
+    
+    // Moved off the plan (e.g. by the operator): re-plan from where it is
+    if (fleet.getNodeID(h) != planNodes[h][planLeg[h]]) {
+        if (!planRoute(aircraft, planNodes[h][planLength[h] - 1])) {
+            cancel(aircraft);
+            return false;
+        }
+    }
+    
+    if (yielding[h]) {
+        // Hold position this tick for predicted traffic
+        fleet.setVelocity(h, 0.0f, 0.0f);
+        yieldCount++;
+        return true;
+    }
+    
+    legFlown[h] += distance;
+    while (true) {
+        int leg = planLeg[h];
+        if (leg >= planLength[h] - 1) {
+            // End of the plan: land at an airport, otherwise hold at the waypoint
+            if (airspace.getNode(planNodes[h][leg])->isAirport) {
+                land(h);
+            } else {
+                cancel(aircraft);
+            }
+            return false;
+        }
+        
+        if (legLength[h] < 0.0) {
+            // Corridor removed since planning
+            if (!planRoute(aircraft, planNodes[h][planLength[h] - 1])) {
+                cancel(aircraft);
+                return false;
+            }
+            continue;
+        }
+        
+        if (legFlown[h] < legLength[h]) {
+            break;
+        }
+        
+        int nextNode = planNodes[h][leg + 1];
+        bool arriving = leg + 1 == planLength[h] - 1 && airspace.getNode(nextNode)->isAirport;
+        GraphNode* next = airspace.getNode(nextNode);
+        if (!arriving && next->occupant != NO_AIRCRAFT && next->occupant != h) {
+            if (isWaitingFor(next->occupant, planNodes[h][leg])) {
+                // Head-on pair on one corridor: pass with vertical separation
+                passHeadOn(h, next->occupant);
+                continue;
+            }
+            // Next node is taken: hold at the end of this leg
+            legFlown[h] = legLength[h];
+            holdCount++;
+            break;
+        }
+        
+        GraphNode* current = airspace.getNode(planNodes[h][leg]);
+        if (current->occupant == h) {
+            airspace.removeAircraft(current->nodeID);
+        }
+        legFlown[h] -= legLength[h];
+        planLeg[h]++;
+        
+        // Landing aircraft never occupy the airport node
+        if (!arriving) {
+            airspace.placeAircraft(nextNode, aircraft);
+            beginLeg(h);
+        }
+    }
+    
+    interpolate(h);
+    return true;
+}
+
+bool SimulationEngine::isMoving(AircraftHandle h) const {
+    // Planned and partway along a leg (a yielding aircraft still counts)
+    return int(h) < slotCapacity && activeIndex[h] != -1 &&
+           legLength[h] > 0.0 && legFlown[h] < legLength[h];
+}
+
+void SimulationEngine::resolvePredicted() {
+    int count = predictor->predict();
+    const PredictedConflict* predictions = predictor->getPredictions();
+    
+    for (int i = 0; i < count; i++) {
+        AircraftHandle first = predictions[i].first;
+        AircraftHandle second = predictions[i].second;
+        
+        // Only moving aircraft can give way; parked traffic is left to
+        // the node-occupancy holds. The less urgent aircraft yields
+        // (ties go to the higher handle).
+        if (isMoving(first) && isMoving(second)) {
+            int firstPriority = fleet.getPriority(first);
+            int secondPriority = fleet.getPriority(second);
+            bool firstYields = firstPriority > secondPriority ||
+                               (firstPriority == secondPriority && first > second);
+            AircraftHandle yielder = firstYields ? first : second;
+            AircraftHandle other = firstYields ? second : first;
+            if (!yielding[other]) {
+                yielding[yielder] = 1;
+            }
+        }
+        
+        if (predictions[i].timeToClosest <= imminentWindow) {
+            AircraftHandle pair[2] = { first, second };
+            landingQueue.escalateBatch(pair, 2, Priority::HIGH);
+        }
+    }
+}
+
+void SimulationEngine::step() {
+    tickCount++;
+    clock += tickMinutes;
+    
+    // Fuel for the whole airborne fleet in one pass
+    const AircraftHandle* crossed;
+    int lowFuel = fleet.burnFuel(tickMinutes, lowFuelThreshold, crossed);
+    if (lowFuel > 0) {
+        landingQueue.escalateBatch(crossed, lowFuel, Priority::HIGH);
+    }
+    
+    if (predictor != nullptr) {
+        resolvePredicted();
+    }
+    
+    // Backwards, so aircraft swapped in by a landing were already moved
+    double distance = cruiseSpeed * tickMinutes;
+    for (int i = activeCount - 1; i >= 0; i--) {
+        advance(active[i], distance);
+    }
+    
+    if (predictor != nullptr) {
+        // Yields last one tick; the next look-ahead decides again
+        const PredictedConflict* predictions = predictor->getPredictions();
+        for (int i = 0; i < predictor->getPredictionCount(); i++) {
+            if (int(predictions[i].first) < slotCapacity) yielding[predictions[i].first] = 0;
+            if (int(predictions[i].second) < slotCapacity) yielding[predictions[i].second] = 0;
+        }
+    }
+    
+    if (conflicts != nullptr) {
+        lastConflicts = conflicts->detect();
+        conflictCount += lastConflicts;
+    }
+}
+
+int SimulationEngine::run(int ticks) {
+    int landedBefore = landedCount;
+    for (int i = 0; i < ticks; i++) {
+        step();
+    }
+    return landedCount - landedBefore;
+}
+
+bool SimulationEngine::getPosition(const Aircraft* aircraft, double& x, double& y) const {
+    if (aircraft == nullptr) {
+        return false;
+    }
+    x = fleet.getTrackX(aircraft->getHandle());
+    y = fleet.getTrackY(aircraft->getHandle());
+    return true;
+}
+
@@ -0,0 +1,129 @@
+#ifndef SIMULATIONENGINE_H
+#define SIMULATIONENGINE_H
+
+#include "Graph.h"
+#include "LandingQueue.h"
+#include "HashTable.h"
+#include "FlightLog.h"
+#include "RouteWorkspace.h"
+#include "FleetStore.h"
+#include "ConflictDetector.h"
+#include "ConflictPredictor.h"
+
+// Fixed-tick simulation of the airspace. Each tick burns fuel fleet-wide,
+// moves every aircraft with a flight plan along its route edges, and lands
+// aircraft that reach an airport at the end of their plan.
+//
+// An aircraft keeps occupying the node it is leaving until it arrives at
+// the next one, so the Graph's one-aircraft-per-node rule still holds; an
+// aircraft whose next node is occupied holds at the end of its current leg,
+// except that two aircraft waiting for each other's node pass head-on.
+//
+// With a ConflictPredictor attached, each tick starts with a look-ahead
+// over the current tracks. Of two moving aircraft predicted to lose
+// separation, the less urgent one holds position for the tick, and pairs
+// whose closest approach is imminent are escalated to HIGH in the landing
+// queue so they are cleared out of the sky first.
+// Positions between nodes are interpolated along the edge into the fleet's
+// track arrays, so the radar and conflict detection see aircraft in motion.
+class SimulationEngine {
+private:
+    Graph& airspace;
+    LandingQueue& landingQueue;
+    HashTable& registry;
+    FlightLog& flightLogs;
+    FleetStore& fleet;
+    RouteWorkspace* workspace;
+    RoutePath* scratchPath;
+    ConflictDetector* conflicts;  // Optional separation check after each tick
+    ConflictPredictor* predictor; // Optional look-ahead before each tick
+    
+    // Flight-plan state, indexed by AircraftHandle
+    int** planNodes;      // Route node IDs; buffers are kept and reused per slot
+    int* planCapacity;
+    int* planLength;      // 0 when the aircraft has no plan
+    int* planLeg;         // Index in planNodes of the node being left
+    double* legLength;    // km of the current leg
+    double* legFlown;     // km flown along the current leg
+    int* activeIndex;     // Position in active[] (-1 if not planned)
+    unsigned char* yielding;  // Holds this tick for a predicted conflict
+    int slotCapacity;
+    
+    // Dense list of planned aircraft, visited every tick
+    AircraftHandle* active;
+    int activeCount;
+    int activeCapacity;
+    
+    double tickMinutes;       // Simulated time per tick
+    double cruiseSpeed;       // km per simulated minute
+    double lowFuelThreshold;  // Fuel % that escalates to HIGH priority
+    double imminentWindow;    // Minutes to closest approach that escalates a pair
+    
+    double clock;             // Simulated minutes since construction
+    long long tickCount;
+    int landedCount;
+    int holdCount;            // Ticks an aircraft spent waiting for a node
+    long long conflictCount;  // Conflict pairs summed over all ticks
+    int lastConflicts;        // Conflict pairs after the latest tick
+    long long yieldCount;     // Ticks an aircraft held for predicted traffic
+    
+    void ensureSlots(AircraftHandle h);
+    bool startPlan(AircraftHandle h, const RoutePath& path);
+    void beginLeg(AircraftHandle h);
+    bool advance(AircraftHandle h, double distance);  // false once the aircraft left the plan
+    void land(AircraftHandle h);
+    bool isWaitingFor(AircraftHandle other, int nodeID) const;  // other holds, next node nodeID
+    void passHeadOn(AircraftHandle h, AircraftHandle other);
+    bool isMoving(AircraftHandle h) const;
+    void resolvePredicted();  // Pick yielding aircraft, escalate imminent pairs
+    void interpolate(AircraftHandle h);
+    
+    SimulationEngine(const SimulationEngine&);
+    SimulationEngine& operator=(const SimulationEngine&);
+    
+public:
+    SimulationEngine(Graph& graph, LandingQueue& queue, HashTable& aircraftRegistry,
+                     FlightLog& logs, double tickLength = 1.0, double speed = 8.0);
+    ~SimulationEngine();
+    
+    // Flight plans. The aircraft must be in the airspace; the route is the
+    // shortest path from its current node (A*).
+    bool planRoute(Aircraft* aircraft, int destinationNode);
+    bool planToDestination(Aircraft* aircraft);  // Its destination airport, else the nearest one
+    int planAll();  // Plan every registered airborne aircraft that has no plan
+    void cancel(Aircraft* aircraft);  // Drop the plan; call before deleting a planned aircraft
+    bool hasPlan(const Aircraft* aircraft) const;
+    
+    // New traffic: place the aircraft at originNode, register and queue it,
+    // and plan it to destinationNode. Fails (leaving the aircraft to the
+    // caller) if the origin is occupied, the ID is taken or no route exists.
+    bool spawnFlight(Aircraft* aircraft, int originNode, int destinationNode);
+    
+    // Time
+    void step();  // One tick
+    int run(int ticks);  // Returns aircraft landed during the run
+    
+    // Settings
+    void setTickLength(double minutes) { tickMinutes = minutes; }
+    double getTickLength() const { return tickMinutes; }
+    void setCruiseSpeed(double kmPerMinute) { cruiseSpeed = kmPerMinute; }
+    double getCruiseSpeed() const { return cruiseSpeed; }
+    void setLowFuelThreshold(double percent) { lowFuelThreshold = percent; }
+    void setConflictDetector(ConflictDetector* detector) { conflicts = detector; }
+    void setConflictPredictor(ConflictPredictor* lookAhead) { predictor = lookAhead; }
+    void setImminentWindow(double minutes) { imminentWindow = minutes; }
+    
+    // Queries
+    bool getPosition(const Aircraft* aircraft, double& x, double& y) const;
+    double getClock() const { return clock; }
+    long long getTickCount() const { return tickCount; }
+    int getLandedCount() const { return landedCount; }
+    int getHoldCount() const { return holdCount; }
+    int getActiveCount() const { return activeCount; }
+    long long getConflictCount() const { return conflictCount; }
+    int getLastConflictCount() const { return lastConflicts; }
+    long long getYieldCount() const { return yieldCount; }
+};
+
+#endif // SIMULATIONENGINE_H
+
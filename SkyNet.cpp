@@ -1,23 +1,41 @@
 #include "SkyNet.h"
+#include "Metrics.h"
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <cstring>
 #include <cstdlib>
+#include <chrono>
 using namespace std;
 
-SkyNet::SkyNet() : nextFlightNumber(1) {
-    airspace = new Graph(100);
-    landingQueue = new MinHeap(100);
-    aircraftRegistry = new HashTable(101);
-    flightLogs = new AVLTree();
+SkyNet::SkyNet(int nodeCapacity, int aircraftCapacity, bool bucketedLandingQueue)
+    : nextFlightNumber(1) {
+    airspace = new Graph(nodeCapacity);
+    if (bucketedLandingQueue) {
+        landingQueue = new BucketQueue(aircraftCapacity);
+    } else {
+        landingQueue = new MinHeap(aircraftCapacity);
+    }
+    // Sized so the initial fleet fits under the default load factor
+    aircraftRegistry = new HashTable(aircraftCapacity + aircraftCapacity / 4 + 1);
+    landingQueue->setRegistry(aircraftRegistry);
+    flightLogs = new FlightLog();
+    routeWorkspace = new RouteWorkspace(nodeCapacity);
+    routePath = new RoutePath();
     
     initializeAirspace();
     
-    radar = new Radar(airspace);
+    conflictDetector = new ConflictDetector();
+    conflictPredictor = new ConflictPredictor();
+    attachAirspace();
 }
 
 SkyNet::~SkyNet() {
+    delete engine;
+    delete conflictPredictor;
+    delete conflictDetector;
+    delete routePath;
+    delete routeWorkspace;
     delete radar;
     delete flightLogs;
     delete aircraftRegistry;
@@ -25,6 +43,15 @@ SkyNet::~SkyNet() {
     delete airspace;
 }
 
+void SkyNet::attachAirspace() {
+    radar = new Radar(airspace);
+    radar->setConflictDetector(conflictDetector);
+    radar->setConflictPredictor(conflictPredictor);
+    engine = new SimulationEngine(*airspace, *landingQueue, *aircraftRegistry, *flightLogs);
+    engine->setConflictDetector(conflictDetector);
+    engine->setConflictPredictor(conflictPredictor);
+}
+
 void SkyNet::initializeAirspace() {
     // Create airports
     int jfk = airspace->addNode("JFK", true, 2, 2);
@@ -93,8 +120,22 @@ cin.ignore();
 cin.get();
 }
 
+bool SkyNet::checkNewFlightId(const FlightId& flightID, ostream& out) {
+    if (flightID.isEmpty()) {
+out << "Error: Flight ID must be 1-" << FlightId::MAX_LENGTH << " characters!\n";
+        return false;
+    }
+    
+    // Check if flight already exists
+    if (aircraftRegistry->search(flightID) != nullptr) {
+out << "Error: Flight ID already exists!\n";
+        return false;
+    }
+    return true;
+}
+
 void SkyNet::addFlight() {
-    char flightID[100];
+    FlightId flightID;
     char model[100];
     char origin[100];
     char dest[100];
@@ -105,9 +146,7 @@ cout << "\n=== Add New Flight ===\n";
 cout << "Enter Flight ID (e.g., PK-786): ";
 cin >> flightID;
     
-    // Check if flight already exists
-    if (aircraftRegistry->search(flightID) != nullptr) {
-cout << "Error: Flight ID already exists!\n";
+    if (!checkNewFlightId(flightID, cout)) {
         return;
     }
     
@@ -128,6 +167,17 @@ cout << "4. Emergency\n";
 cout << "Choice: ";
 cin >> typeChoice;
     
+    addFlight(flightID, model, origin, dest, fuel, typeChoice, cout);
+}
+
+bool SkyNet::addFlight(const FlightId& flightID, const char* model, const char* origin,
+                       const char* dest, double fuel, int typeChoice, ostream& out,
+                       int priorityChoice) {
+    OperationTimer timer(Metric::SKYNET_ADD_FLIGHT);
+    if (!checkNewFlightId(flightID, out)) {
+        return false;
+    }
+    
     AircraftType type = AircraftType::COMMERCIAL;
     Priority priority = Priority::MEDIUM;
     
@@ -149,30 +199,35 @@ cin >> typeChoice;
             priority = Priority::CRITICAL;
             break;
         default:
-cout << "Invalid choice, defaulting to Commercial.\n";
+out << "Invalid choice, defaulting to Commercial.\n";
     }
     
     // Auto-adjust priority based on fuel
     if (fuel < 10.0) {
         priority = Priority::HIGH;
     }
+    if (priorityChoice >= 1 && priorityChoice <= 4) {
+        priority = Priority(priorityChoice);
+    }
     
-    Aircraft* aircraft = createAircraft(flightID, model, origin, dest, fuel, priority, type);
+    Aircraft* aircraft = createAircraft(flightID.c_str(), model, origin, dest, fuel, priority, type);
     
-    // Find an entry node (waypoint or airport)
-    int entryNode = -1;
-    for (int i = 0; i < airspace->getNodeCount(); i++) {
+    // Enter at the origin if it is a free node, else the first free node (waypoint or airport)
+    int entryNode = airspace->findNodeByName(origin);
+    if (entryNode != -1 && airspace->isNodeOccupied(entryNode)) {
+        entryNode = -1;
+    }
+    for (int i = 0; entryNode == -1 && i < airspace->getNodeCount(); i++) {
         GraphNode* node = airspace->getNode(i);
         if (node && !airspace->isNodeOccupied(i)) {
             entryNode = i;
-            break;
         }
     }
     
     if (entryNode == -1) {
-cout << "Error: No available entry points in airspace!\n";
+out << "Error: No available entry points in airspace!\n";
         delete aircraft;
-        return;
+        return false;
     }
     
     // Place aircraft in airspace
@@ -183,45 +238,69 @@ cout << "Error: No available entry points in airspace!\n";
         // Add to landing queue
         landingQueue->insert(aircraft);
         
-cout << "Flight " << flightID << " added successfully!\n";
-cout << "Entry point: " << airspace->getNode(entryNode)->name << "\n";
-    } else {
-cout << "Error: Could not place aircraft in airspace!\n";
-        delete aircraft;
+out << "Flight " << flightID.c_str() << " added successfully!\n";
+out << "Entry point: " << airspace->getNode(entryNode)->name << "\n";
+        return true;
     }
+    
+out << "Error: Could not place aircraft in airspace!\n";
+    delete aircraft;
+    return false;
 }
 
 void SkyNet::declareEmergency() {
-    char flightID[100];
+    FlightId flightID;
 cout << "\n=== Declare Emergency ===\n";
 cout << "Enter Flight ID: ";
 cin >> flightID;
     
+    declareEmergency(flightID, cout);
+}
+
+bool SkyNet::declareEmergency(const FlightId& flightID, ostream& out) {
+    OperationTimer timer(Metric::SKYNET_DECLARE_EMERGENCY);
     Aircraft* aircraft = aircraftRegistry->search(flightID);
     if (aircraft == nullptr) {
-cout << "Error: Flight not found!\n";
-        return;
+out << "Error: Flight not found!\n";
+        return false;
     }
     
     aircraft->declareEmergency();
-    landingQueue->updatePriority(flightID, Priority::CRITICAL);
+    landingQueue->updatePriority(aircraft, Priority::CRITICAL);
     
-cout << "Emergency declared for " << flightID << "!\n";
-cout << "Priority updated to CRITICAL.\n";
+out << "Emergency declared for " << flightID.c_str() << "!\n";
+out << "Priority updated to CRITICAL.\n";
+    
+    // Precomputed divert target, no route search needed
+    int currentNode = aircraft->getCurrentNodeID();
+    int airport = airspace->getNearestAirport(currentNode);
+    if (airport != -1) {
+out << "Nearest airport: " << airspace->getNode(airport)->name
+    << " (" << airspace->getDistanceToNearestAirport(currentNode) << " km)\n";
+        int nextHop = airspace->getNextHopToAirport(currentNode);
+        if (nextHop != -1) {
+out << "Next hop: " << airspace->getNode(nextHop)->name << "\n";
+        }
+    }
+    return true;
 }
 
 void SkyNet::landFlight() {
 cout << "\n=== Land Flight ===\n";
-    
+    landFlight(cout);
+}
+
+bool SkyNet::landFlight(ostream& out) {
+    OperationTimer timer(Metric::SKYNET_LAND_FLIGHT);
     if (landingQueue->isEmpty()) {
-cout << "No aircraft in landing queue.\n";
-        return;
+out << "No aircraft in landing queue.\n";
+        return false;
     }
     
     Aircraft* aircraft = landingQueue->extractMin();
     if (aircraft == nullptr) {
-cout << "Error: Could not process landing.\n";
-        return;
+out << "Error: Could not process landing.\n";
+        return false;
     }
     
     // Remove from airspace
@@ -234,38 +313,64 @@ cout << "Error: Could not process landing.\n";
     // Add to flight logs
     flightLogs->insert(aircraft, aircraft->getArrivalTimestamp());
     
-cout << "Flight " << aircraft->getFlightID() << " has landed successfully!\n";
-cout << "Status: " << (aircraft->getIsCrashed() ? "CRASHED" : "SAFE") << "\n";
+out << "Flight " << aircraft->getFlightID() << " has landed successfully!\n";
+out << "Status: " << (aircraft->getIsCrashed() ? "CRASHED" : "SAFE") << "\n";
+    
+    // The log keeps its own record, so the aircraft can be released
+    engine->cancel(aircraft);
+    aircraftRegistry->remove(aircraft->getFlightId());
+    delete aircraft;
+    return true;
 }
 
 void SkyNet::searchFlight() {
-    char flightID[100];
+    FlightId flightID;
 cout << "\n=== Search Flight ===\n";
 cout << "Enter Flight ID: ";
 cin >> flightID;
     
+    searchFlight(flightID, cout);
+}
+
+bool SkyNet::searchFlight(const FlightId& flightID, ostream& out) {
+    OperationTimer timer(Metric::SKYNET_SEARCH_FLIGHT);
     Aircraft* aircraft = aircraftRegistry->search(flightID);
     if (aircraft == nullptr) {
-cout << "Flight not found!\n";
-        return;
+        // Landed flights only live on in the log
+        const LogRecord* record = flightLogs->findLatest(flightID.c_str());
+        if (record == nullptr) {
+out << "Flight not found!\n";
+            return false;
+        }
+        
+out << "\n=== Flight Information (Log) ===\n";
+out << "Flight ID: " << flightLogs->getText(record->flightID) << "\n";
+out << "Model: " << flightLogs->getText(record->model) << "\n";
+out << "Origin: " << flightLogs->getText(record->origin) << "\n";
+out << "Destination: " << flightLogs->getText(record->destination) << "\n";
+out << "Final Fuel: " << record->finalFuel << "%\n";
+out << "Arrival Timestamp: " << record->timestamp << "\n";
+out << "Status: " << ((record->status & LOG_CRASHED) ? "CRASHED" : "LANDED") << "\n";
+        return true;
     }
     
-cout << "\n=== Flight Information ===\n";
-cout << "Flight ID: " << aircraft->getFlightID() << "\n";
-cout << "Model: " << aircraft->getModel() << "\n";
-cout << "Origin: " << aircraft->getOrigin() << "\n";
-cout << "Destination: " << aircraft->getDestination() << "\n";
-cout << "Fuel Level: " << aircraft->getFuelLevel() << "%\n";
-cout << "Priority: " << aircraft->getPriorityString() << "\n";
-cout << "Type: " << aircraft->getTypeString() << "\n";
-cout << "Position: [" << aircraft->getCurrentX() << "," << aircraft->getCurrentY() << "]\n";
+out << "\n=== Flight Information ===\n";
+out << "Flight ID: " << aircraft->getFlightID() << "\n";
+out << "Model: " << aircraft->getModel() << "\n";
+out << "Origin: " << aircraft->getOrigin() << "\n";
+out << "Destination: " << aircraft->getDestination() << "\n";
+out << "Fuel Level: " << aircraft->getFuelLevel() << "%\n";
+out << "Priority: " << aircraft->getPriorityString() << "\n";
+out << "Type: " << aircraft->getTypeString() << "\n";
+out << "Position: [" << aircraft->getCurrentX() << "," << aircraft->getCurrentY() << "]\n";
     
     GraphNode* node = airspace->getNode(aircraft->getCurrentNodeID());
     if (node) {
-cout << "Current Location: " << node->name << "\n";
+out << "Current Location: " << node->name << "\n";
     }
     
-cout << "Status: " << (aircraft->getIsLanded() ? "LANDED" : "IN FLIGHT") << "\n";
+out << "Status: " << (aircraft->getIsLanded() ? "LANDED" : "IN FLIGHT") << "\n";
+    return true;
 }
 
 void SkyNet::printLog() {
@@ -275,77 +380,132 @@ cin.ignore();
 cin.get();
 }
 
+void SkyNet::printLogReport() {
+    long long from, to;
+cout << "\n=== Log Report ===\n";
+cout << "Total entries: " << flightLogs->getLogCount() << "\n";
+    
+    const LogRecord* latest = flightLogs->getNthMostRecent(1);
+    if (latest) {
+cout << "Most recent landing: " << flightLogs->getText(latest->flightID)
+     << " at " << latest->timestamp << "\n";
+    }
+    
+cout << "Enter start timestamp: ";
+cin >> from;
+cout << "Enter end timestamp: ";
+cin >> to;
+    
+    flightLogs->printRange(from, to);
+cout << "Landings since " << from << ": " << flightLogs->countSince(from) << "\n";
+}
+
+void SkyNet::printConflictForecast() {
+    printConflictForecast(cout);
+}
+
+bool SkyNet::printConflictForecast(ostream& out) {
+    OperationTimer timer(Metric::SKYNET_CONFLICT_FORECAST);
+out << "\n=== Conflict Forecast ===\n";
+    
+    int count = conflictPredictor->predict();
+out << "Look-ahead: " << conflictPredictor->getHorizon() << " min, separation minimum: "
+    << conflictPredictor->getSeparation() << " grid units\n";
+    if (count == 0) {
+out << "No conflicts predicted.\n";
+        return true;
+    }
+    
+    const PredictedConflict* predictions = conflictPredictor->getPredictions();
+    for (int i = 0; i < count; i++) {
+        Aircraft* first = Aircraft::fromHandle(predictions[i].first);
+        Aircraft* second = Aircraft::fromHandle(predictions[i].second);
+out << first->getFlightID() << " - " << second->getFlightID()
+    << ": closest " << predictions[i].missDistance << " grid units in "
+    << predictions[i].timeToClosest << " min\n";
+    }
+    return true;
+}
+
 void SkyNet::findSafeRoute() {
-    char flightID[100];
+    FlightId flightID;
 cout << "\n=== Find Safe Route ===\n";
 cout << "Enter Flight ID: ";
 cin >> flightID;
     
+    findSafeRoute(flightID, cout);
+}
+
+bool SkyNet::findSafeRoute(const FlightId& flightID, ostream& out) {
+    OperationTimer timer(Metric::SKYNET_FIND_SAFE_ROUTE);
     Aircraft* aircraft = aircraftRegistry->search(flightID);
     if (aircraft == nullptr) {
-cout << "Error: Flight not found!\n";
-        return;
+out << "Error: Flight not found!\n";
+        return false;
     }
     
     int currentNode = aircraft->getCurrentNodeID();
     if (currentNode == -1) {
-cout << "Error: Aircraft not in airspace!\n";
-        return;
+out << "Error: Aircraft not in airspace!\n";
+        return false;
     }
     
-    Graph::PathResult* result = airspace->findShortestPathToNearestAirport(currentNode);
-    
-    if (result == nullptr || result->pathLength == 0) {
-cout << "Error: No route to airport found!\n";
-        delete result;
-        return;
+    if (!airspace->findShortestPathToNearestAirport(currentNode, *routeWorkspace, *routePath)) {
+out << "Error: No route to airport found!\n";
+        return false;
     }
     
-cout << "\n=== Safe Route to Nearest Airport ===\n";
-cout << "Total Distance: " << result->totalDistance << " km\n";
-cout << "Path: ";
+out << "\n=== Safe Route to Nearest Airport ===\n";
+out << "Total Distance: " << routePath->totalDistance << " km\n";
+out << "Path: ";
     
-    for (int i = 0; i < result->pathLength; i++) {
-        GraphNode* node = airspace->getNode(result->path[i]);
+    for (int i = 0; i < routePath->length; i++) {
+        GraphNode* node = airspace->getNode(routePath->nodes[i]);
         if (node) {
-cout << node->name;
-            if (i < result->pathLength - 1) {
-cout << " -> ";
+out << node->name;
+            if (i < routePath->length - 1) {
+out << " -> ";
             }
         }
     }
-cout << "\n";
+out << "\n";
+    return true;
+}
+
+Aircraft* SkyNet::findMovableAircraft(const FlightId& flightID, ostream& out) {
+    Aircraft* aircraft = aircraftRegistry->search(flightID);
+    if (aircraft == nullptr) {
+out << "Error: Flight not found!\n";
+        return nullptr;
+    }
     
-    delete result;
+    if (aircraft->getIsLanded()) {
+out << "Error: Aircraft has already landed!\n";
+        return nullptr;
+    }
+    
+    if (aircraft->getCurrentNodeID() == -1) {
+out << "Error: Aircraft not in airspace!\n";
+        return nullptr;
+    }
+    return aircraft;
 }
 
 void SkyNet::moveAircraft() {
-    char flightID[100];
+    FlightId flightID;
     int targetNode;
     
 cout << "\n=== Move Aircraft ===\n";
 cout << "Enter Flight ID: ";
 cin >> flightID;
     
-    Aircraft* aircraft = aircraftRegistry->search(flightID);
+    Aircraft* aircraft = findMovableAircraft(flightID, cout);
     if (aircraft == nullptr) {
-cout << "Error: Flight not found!\n";
-        return;
-    }
-    
-    if (aircraft->getIsLanded()) {
-cout << "Error: Aircraft has already landed!\n";
-        return;
-    }
-    
-    int currentNode = aircraft->getCurrentNodeID();
-    if (currentNode == -1) {
-cout << "Error: Aircraft not in airspace!\n";
         return;
     }
     
 cout << "Current location: ";
-    GraphNode* current = airspace->getNode(currentNode);
+    GraphNode* current = airspace->getNode(aircraft->getCurrentNodeID());
     if (current) {
 cout << current->name << "\n";
     }
@@ -353,51 +513,150 @@ cout << current->name << "\n";
 cout << "Enter target node ID: ";
 cin >> targetNode;
     
+    moveAircraft(flightID, targetNode, cout);
+}
+
+bool SkyNet::moveAircraft(const FlightId& flightID, int targetNode, ostream& out) {
+    OperationTimer timer(Metric::SKYNET_MOVE_AIRCRAFT);
+    Aircraft* aircraft = findMovableAircraft(flightID, out);
+    if (aircraft == nullptr) {
+        return false;
+    }
+    int currentNode = aircraft->getCurrentNodeID();
+    
     // Collision avoidance check
     if (airspace->isNodeOccupied(targetNode)) {
         Aircraft* blockingAircraft = airspace->getAircraftAtNode(targetNode);
-cout << "\n*** COLLISION ALERT! ***\n";
-cout << "Target node is occupied by: " << blockingAircraft->getFlightID() << "\n";
-cout << "Movement blocked. Aircraft held at current position.\n";
-        return;
+out << "\n*** COLLISION ALERT! ***\n";
+out << "Target node is occupied by: " << blockingAircraft->getFlightID() << "\n";
+out << "Movement blocked. Aircraft held at current position.\n";
+        return false;
     }
     
-    // Check if there's a path
-    Graph::PathResult* path = airspace->findShortestPath(currentNode, targetNode);
-    if (path == nullptr || path->pathLength == 0) {
-cout << "Error: No valid path to target node!\n";
-        delete path;
-        return;
+    // Check if there's a path (A* since the target is known)
+    if (!airspace->findShortestPath(currentNode, targetNode, RouteAlgorithm::ASTAR,
+                                    *routeWorkspace, *routePath)) {
+out << "Error: No valid path to target node!\n";
+        return false;
+    }
+    
+    // Look-ahead: would it be in the way of traffic once it is there?
+    GraphNode* target = airspace->getNode(targetNode);
+    AircraftHandle traffic;
+    float eta, miss;
+    if (conflictPredictor->predictFor(aircraft->getHandle(), float(target->gridX), float(target->gridY),
+                                      0.0f, 0.0f, traffic, eta, miss) > 0) {
+out << "\n*** PREDICTED CONFLICT! ***\n";
+out << "Traffic " << Aircraft::fromHandle(traffic)->getFlightID() << " would pass within "
+    << miss << " grid units in " << eta << " min.\n";
+out << "Movement blocked. Aircraft held at current position.\n";
+        return false;
     }
     
-    // Move aircraft
+    // Move aircraft; a manual move overrides any flight plan
+    engine->cancel(aircraft);
     airspace->removeAircraft(currentNode);
     if (airspace->placeAircraft(targetNode, aircraft)) {
-cout << "Aircraft " << flightID << " moved successfully to node " << targetNode << "\n";
+out << "Aircraft " << flightID.c_str() << " moved successfully to node " << targetNode << "\n";
         
         // Consume some fuel
         aircraft->updateFuel(-2.0);  // Consume 2% fuel per move
         
         if (aircraft->getFuelLevel() < 10.0 && aircraft->getPriority() != Priority::CRITICAL) {
             aircraft->setPriority(Priority::HIGH);
-            landingQueue->updatePriority(flightID, Priority::HIGH);
-cout << "Warning: Low fuel! Priority upgraded to HIGH.\n";
+            landingQueue->updatePriority(aircraft, Priority::HIGH);
+out << "Warning: Low fuel! Priority upgraded to HIGH.\n";
         }
-    } else {
-cout << "Error: Could not move aircraft!\n";
-        airspace->placeAircraft(currentNode, aircraft);  // Restore to original position
+        return true;
     }
     
-    delete path;
+out << "Error: Could not move aircraft!\n";
+    airspace->placeAircraft(currentNode, aircraft);  // Restore to original position
+    return false;
+}
+
+void SkyNet::advanceTime() {
+    double minutes;
+cout << "\n=== Advance Time ===\n";
+cout << "Enter elapsed time (minutes): ";
+cin >> minutes;
+    
+    advanceTime(minutes, cout);
+}
+
+bool SkyNet::advanceTime(double minutes, ostream& out) {
+    OperationTimer timer(Metric::SKYNET_ADVANCE_TIME);
+    // One vectorized pass over the fleet's fuel array
+    const AircraftHandle* crossed;
+    int lowFuel = FleetStore::shared().burnFuel(minutes, 10.0, crossed);
+    int escalated = landingQueue->escalateBatch(crossed, lowFuel, Priority::HIGH);
+    
+out << "Fuel burned for " << FleetStore::shared().getLiveCount() << " aircraft.\n";
+    if (lowFuel == 0) {
+out << "No aircraft dropped below 10% fuel.\n";
+        return true;
+    }
+    
+out << "Low fuel (< 10%), " << escalated << " escalated in the landing queue:\n";
+    for (int i = 0; i < lowFuel; i++) {
+        Aircraft* aircraft = Aircraft::fromHandle(crossed[i]);
+out << "  " << aircraft->getFlightID() << " - Fuel: " << aircraft->getFuelLevel()
+    << "%, Priority: " << aircraft->getPriorityString() << "\n";
+    }
+    return true;
+}
+
+void SkyNet::runSimulation() {
+    int ticks;
+cout << "\n=== Run Simulation ===\n";
+cout << "Tick: " << engine->getTickLength() << " min, cruise speed: "
+     << engine->getCruiseSpeed() * 60.0 << " km/h\n";
+cout << "Enter number of ticks: ";
+cin >> ticks;
+    
+    runSimulation(ticks, cout);
+}
+
+bool SkyNet::runSimulation(int ticks, ostream& out) {
+    OperationTimer timer(Metric::SKYNET_RUN_SIMULATION);
+    if (ticks <= 0) {
+out << "Error: Tick count must be positive!\n";
+        return false;
+    }
+    
+    // Aircraft without a plan head for their destination (or nearest) airport
+    int planned = engine->planAll();
+    
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int landed = engine->run(ticks);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+out << "New flight plans: " << planned << "\n";
+out << "Simulated " << ticks * engine->getTickLength() << " minutes (clock "
+    << engine->getClock() << " min)\n";
+out << "Landed: " << landed << ", still flying: " << engine->getActiveCount()
+    << ", holds so far: " << engine->getHoldCount() << "\n";
+out << "Separation conflicts: " << engine->getLastConflictCount() << " now, "
+    << engine->getConflictCount() << " pair-ticks so far\n";
+out << "Holds for predicted traffic: " << engine->getYieldCount() << "\n";
+    if (seconds > 0.0) {
+out << "Throughput: " << long(ticks / seconds) << " ticks/s\n";
+    }
+    return true;
 }
 
 void SkyNet::saveState() {
-    cout << "\n=== Save State ===\n";
+    saveState(cout);
+}
+
+bool SkyNet::saveState(ostream& out) {
+    OperationTimer timer(Metric::SKYNET_SAVE_STATE);
+    out << "\n=== Save State ===\n";
     
     ofstream file("skynet_save.txt");
     if (!file.is_open()) {
-        cout << "Error: Could not create save file!\n";
-        return;
+        out << "Error: Could not create save file!\n";
+        return false;
     }
     
     // Save aircraft registry
@@ -428,16 +687,22 @@ void SkyNet::saveState() {
     file.close();
     flightLogs->saveToFile("skynet_logs.txt");
     
-    cout << "State saved successfully!\n";
+    out << "State saved successfully!\n";
+    return true;
 }
 
 void SkyNet::loadState() {
-    cout << "\n=== Load State ===\n";
+    loadState(cout);
+}
+
+bool SkyNet::loadState(ostream& out) {
+    OperationTimer timer(Metric::SKYNET_LOAD_STATE);
+    out << "\n=== Load State ===\n";
     
     ifstream file("skynet_save.txt");
     if (!file.is_open()) {
-        cout << "No save file found. Starting fresh.\n";
-        return;
+        out << "No save file found. Starting fresh.\n";
+        return false;
     }
     
     string section;
@@ -454,6 +719,7 @@ void SkyNet::loadState() {
         int priority, type, x, y, nodeID, landed;
         long long timestamp;
         char delimiter;
+        int skipped = 0;
         
         for (int i = 0; i < count; i++) {
             file.getline(flightID, 100, '|');
@@ -470,6 +736,16 @@ void SkyNet::loadState() {
             file >> timestamp;
             file.ignore();  // Skip newline
             
+            if (!file) {
+                break;  // Truncated or unreadable record
+            }
+            if (priority < int(Priority::CRITICAL) || priority > int(Priority::LOW) ||
+                type < int(AircraftType::COMMERCIAL) || type > int(AircraftType::EMERGENCY)) {
+                // Hand-edited or corrupt record; the queues cannot hold it
+                skipped++;
+                continue;
+            }
+            
             Aircraft* ac = createAircraft(flightID, model, origin, destination, fuel,
                                          (Priority)priority, (AircraftType)type);
             ac->setPosition(x, y);
@@ -477,18 +753,138 @@ void SkyNet::loadState() {
             ac->setLanded(landed == 1);
             ac->setArrivalTimestamp(timestamp);
             
-            aircraftRegistry->insert(flightID, ac);
-            if (!ac->getIsLanded()) {
-                airspace->placeAircraft(nodeID, ac);
-                landingQueue->insert(ac);
+            if (ac->getIsLanded()) {
+                // Older saves kept landed aircraft; the log already has them
+                delete ac;
+                continue;
+            }
+            if (aircraftRegistry->search(ac->getFlightId()) != nullptr) {
+                // Already flying (state loaded twice)
+                delete ac;
+                continue;
             }
+            
+            if (!aircraftRegistry->insert(ac->getFlightId(), ac)) {
+                // Flight ID too long to key the registry
+                skipped++;
+                delete ac;
+                continue;
+            }
+            airspace->placeAircraft(nodeID, ac);
+            landingQueue->insert(ac);
+        }
+        if (skipped > 0) {
+            out << "Skipped " << skipped << " record(s) with an invalid flight ID, priority or type.\n";
         }
     }
     
     file.close();
-    flightLogs->loadFromFile("skynet_logs.txt");
+    int skippedLogs = 0;
+    flightLogs->loadFromFile("skynet_logs.txt", &skippedLogs);
+    if (skippedLogs > 0) {
+        out << "Skipped " << skippedLogs << " log record(s) with an invalid priority or type.\n";
+    }
     
-    cout << "State loaded successfully!\n";
+    out << "State loaded successfully!\n";
+    return true;
+}
+
+bool SkyNet::generateAirspace(const char* kind, int a, int b, unsigned long long seed,
+                              ostream& out) {
+    bool grid = strcmp(kind, "grid") == 0;
+    if (!grid && strcmp(kind, "random") != 0) {
+out << "Error: Airspace kind must be grid or random!\n";
+        return false;
+    }
+    if (a < 2 || (grid && b < 1) || (!grid && b < a - 1)) {
+out << "Error: Airspace too small!\n";
+        return false;
+    }
+    if (aircraftRegistry->getCount() > 0) {
+out << "Error: Airspace can only be replaced while no aircraft are flying!\n";
+        return false;
+    }
+    
+    // Radar and engine hold on to the old graph, so they go with it
+    delete engine;
+    delete radar;
+    delete airspace;
+    
+    airspace = new Graph(grid ? a * b : a);
+    TrafficGenerator generator(seed);
+    if (grid) {
+        generator.buildGridAirspace(*airspace, a, b);
+    } else {
+        generator.buildRandomAirspace(*airspace, a, b);
+    }
+    attachAirspace();
+    
+    int airports = 0;
+    for (int i = 0; i < airspace->getNodeCount(); i++) {
+        if (airspace->getNode(i)->isAirport) {
+            airports++;
+        }
+    }
+out << "Generated " << kind << " airspace: " << airspace->getNodeCount() << " nodes, "
+    << airports << " airports (seed " << seed << ")\n";
+    return true;
+}
+
+void SkyNet::printRegistryStats() {
+    aircraftRegistry->printStats();
+    
+    const PoolStats& nodes = airspace->getNodePoolStats();
+    const PoolStats& edges = airspace->getEdgePoolStats();
+    const PoolStats& names = airspace->getNameArenaStats();
+cout << "\n=== Airspace Pools ===\n";
+cout << "Nodes: " << nodes.live << " live, " << nodes.slabAllocs << " global allocations\n";
+cout << "Edges: " << edges.live << " live, " << edges.released << " recycled, "
+     << edges.slabAllocs << " global allocations\n";
+cout << "Names: " << names.live << " strings, " << names.slabAllocs << " global allocations\n";
+}
+
+void SkyNet::refreshGauges() {
+    Metrics& metrics = Metrics::shared();
+    metrics.setGauge(Gauge::HASH_ENTRIES, aircraftRegistry->getCount());
+    metrics.setGauge(Gauge::HASH_TABLE_SIZE, aircraftRegistry->getTableSize());
+    metrics.setGauge(Gauge::HASH_LOAD_FACTOR, aircraftRegistry->getLoadFactor());
+    metrics.setGauge(Gauge::HASH_LONGEST_PROBE, aircraftRegistry->getLongestProbe());
+    
+    // The bucket queue has no depth to report
+    metrics.setGauge(Gauge::HEAP_SIZE, landingQueue->getSize());
+    int depth = landingQueue->getDepth();
+    if (depth >= 0) {
+        metrics.setGauge(Gauge::HEAP_DEPTH, depth);
+    }
+    
+    metrics.setGauge(Gauge::LOG_ENTRIES, flightLogs->getLogCount());
+    metrics.setGauge(Gauge::LOG_CHUNKS, flightLogs->getChunkCount());
+    metrics.setGauge(Gauge::AIRSPACE_NODES, airspace->getNodeCount());
+    metrics.setGauge(Gauge::ACTIVE_FLIGHTS, engine->getActiveCount());
+}
+
+void SkyNet::printPerformanceStats() {
+    printMetrics(cout);
+    writeMetrics("skynet_metrics.json", cout);
+}
+
+bool SkyNet::printMetrics(ostream& out) {
+    refreshGauges();
+    Metrics::shared().print(out);
+    return true;
+}
+
+bool SkyNet::writeMetrics(const char* path, ostream& out) {
+    ofstream file(path);
+    if (!file.is_open()) {
+out << "Error: Could not write " << path << "\n";
+        return false;
+    }
+    
+    refreshGauges();
+    Metrics::shared().writeJson(file);
+out << "Metrics written to " << path << "\n";
+    return true;
 }
 
 void SkyNet::run() {
@@ -539,6 +935,8 @@ cout << "\n1. Add Flight\n";
 cout << "2. Declare Emergency\n";
 cout << "3. Land Flight\n";
 cout << "4. Move Aircraft\n";
+cout << "5. Advance Time\n";
+cout << "6. Run Simulation\n";
 cout << "Choice: ";
 cin >> subChoice;
                 
@@ -550,6 +948,10 @@ cin >> subChoice;
                     landFlight();
                 } else if (subChoice == 4) {
                     moveAircraft();
+                } else if (subChoice == 5) {
+                    advanceTime();
+                } else if (subChoice == 6) {
+                    runSimulation();
                 }
                 
 cout << "\nPress Enter to continue...";
@@ -562,6 +964,8 @@ cin.get();
 cout << "\n1. Search Flight\n";
 cout << "2. Print Flight Log\n";
 cout << "3. Find Safe Route\n";
+cout << "4. Log Report (Time Range)\n";
+cout << "5. Conflict Forecast\n";
 cout << "Choice: ";
 cin >> subChoice;
                 
@@ -571,6 +975,10 @@ cin >> subChoice;
                     printLog();
                 } else if (subChoice == 3) {
                     findSafeRoute();
+                } else if (subChoice == 4) {
+                    printLogReport();
+                } else if (subChoice == 5) {
+                    printConflictForecast();
                 }
                 
 cout << "\nPress Enter to continue...";
@@ -582,6 +990,8 @@ cin.get();
                 int subChoice;
 cout << "\n1. Save State\n";
 cout << "2. Load State\n";
+cout << "3. Registry Stats\n";
+cout << "4. Performance Stats\n";
 cout << "Choice: ";
 cin >> subChoice;
                 
@@ -589,6 +999,10 @@ cin >> subChoice;
                     saveState();
                 } else if (subChoice == 2) {
                     loadState();
+                } else if (subChoice == 3) {
+                    printRegistryStats();
+                } else if (subChoice == 4) {
+                    printPerformanceStats();
                 }
                 
 cout << "\nPress Enter to continue...";
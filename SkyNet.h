@@ -3,52 +3,100 @@
 
 #include "Graph.h"
 #include "MinHeap.h"
+#include "BucketQueue.h"
 #include "HashTable.h"
-#include "AVLTree.h"
+#include "FlightLog.h"
 #include "Radar.h"
+#include "RouteWorkspace.h"
+#include "SimulationEngine.h"
+#include "TrafficGenerator.h"
 #include "Aircraft.h"
+#include <iostream>
+using namespace std;
 
 // Main SkyNet ATC System
 class SkyNet {
 private:
     Graph* airspace;
-    MinHeap* landingQueue;
+    LandingQueue* landingQueue;  // MinHeap or BucketQueue
     HashTable* aircraftRegistry;
-    AVLTree* flightLogs;
+    FlightLog* flightLogs;
     Radar* radar;
+    RouteWorkspace* routeWorkspace;  // Reused by every route query
+    RoutePath* routePath;
+    SimulationEngine* engine;
+    ConflictDetector* conflictDetector;  // Shared by the radar and the engine
+    ConflictPredictor* conflictPredictor;
     
     int nextFlightNumber;
     
     // Helper functions
     void initializeAirspace();
+    void attachAirspace();  // Radar and engine over the current airspace
     Aircraft* createAircraft(const char* flightID, const char* model,
                             const char* origin, const char* dest,
                             double fuel, Priority priority, AircraftType type);
+    bool checkNewFlightId(const FlightId& flightID, ostream& out);
+    Aircraft* findMovableAircraft(const FlightId& flightID, ostream& out);
+    void refreshGauges();  // Structure sizes into Metrics::shared()
     
 public:
-    SkyNet();
+    // Capacities are initial sizes only; every structure grows on demand
+    SkyNet(int nodeCapacity = 100, int aircraftCapacity = 100,
+           bool bucketedLandingQueue = false);
     ~SkyNet();
     
-    // Menu options
+    // Menu options: prompt on cin, then run the matching core operation
     void displayRadar();
     void addFlight();
     void declareEmergency();
     void landFlight();
     void searchFlight();
     void printLog();
+    void printLogReport();  // Counts and entries for a timestamp range
+    void printConflictForecast();  // Predicted losses of separation
     void findSafeRoute();
     void moveAircraft();  // Move aircraft with collision check
+    void advanceTime();   // Burn fuel fleet-wide, escalate low-fuel aircraft
+    void runSimulation(); // Fly every aircraft along its flight plan for N ticks
     void saveState();
     void loadState();
+    void printRegistryStats();  // Registry load plus pool allocation counts
+    void printPerformanceStats();  // Latency histograms and gauges, also saved as JSON
+    
+    // Core operations behind the menu, also driven by ScriptRunner. They
+    // take their inputs as arguments, write results to 'out', never pause
+    // or clear the screen, and return false when the operation failed.
+    // priorityChoice 1-4 overrides the type's usual priority, 0 keeps it
+    bool addFlight(const FlightId& flightID, const char* model, const char* origin,
+                   const char* dest, double fuel, int typeChoice, ostream& out,
+                   int priorityChoice = 0);
+    bool declareEmergency(const FlightId& flightID, ostream& out);
+    bool landFlight(ostream& out);  // Lands the head of the landing queue
+    bool searchFlight(const FlightId& flightID, ostream& out);
+    bool findSafeRoute(const FlightId& flightID, ostream& out);
+    bool moveAircraft(const FlightId& flightID, int targetNode, ostream& out);
+    bool advanceTime(double minutes, ostream& out);
+    bool runSimulation(int ticks, ostream& out);
+    bool printConflictForecast(ostream& out);
+    bool saveState(ostream& out);
+    bool loadState(ostream& out);
+    // Replace the built-in airspace with a generated one; only while no
+    // aircraft are registered. kind is "grid" (a x b nodes) or "random"
+    // (a nodes, b corridors).
+    bool generateAirspace(const char* kind, int a, int b, unsigned long long seed, ostream& out);
+    bool printMetrics(ostream& out);
+    bool writeMetrics(const char* path, ostream& out);  // JSON
     
     // Main menu
     void run();
     
     // Utility
     Graph* getAirspace() { return airspace; }
-    MinHeap* getLandingQueue() { return landingQueue; }
+    LandingQueue* getLandingQueue() { return landingQueue; }
     HashTable* getRegistry() { return aircraftRegistry; }
-    AVLTree* getLogs() { return flightLogs; }
+    FlightLog* getLogs() { return flightLogs; }
+    SimulationEngine* getEngine() { return engine; }
 };
 
 #endif // SKYNET_H
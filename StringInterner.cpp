@@ -0,0 +1,134 @@
+#include "StringInterner.h"
+#include <cstring>
+using namespace std;
+
+StringInterner StringInterner::instance;
+
+StringInterner::StringInterner(int cap)
+    : arenaBytes(0), count(0) {
+    capacity = cap > 0 ? cap : 1;
+    texts = new const char*[capacity];
+    hashes = new unsigned int[capacity];
+    
+    indexSize = 8;
+    while (indexSize < capacity * 2) {
+        indexSize *= 2;
+    }
+    index = new int[indexSize];
+    for (int i = 0; i < indexSize; i++) {
+        index[i] = -1;
+    }
+}
+
+StringInterner::~StringInterner() {
+    delete[] texts;
+    delete[] hashes;
+    delete[] index;
+}
+
+unsigned int StringInterner::hashString(const char* text) {
+    // 32-bit FNV-1a
+    unsigned int h = 2166136261u;
+    for (int i = 0; text[i] != '\0'; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+int StringInterner::findSlot(const char* text, unsigned int hash) const {
+    // Returns the slot holding text, or the empty slot where it belongs
+    int mask = indexSize - 1;
+    int slot = int(hash & mask);
+    while (index[slot] != -1) {
+        int id = index[slot];
+        if (hashes[id] == hash && strcmp(texts[id], text) == 0) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void StringInterner::growIds() {
+    int newCapacity = capacity * 2;
+    const char** newTexts = new const char*[newCapacity];
+    unsigned int* newHashes = new unsigned int[newCapacity];
+    for (int i = 0; i < count; i++) {
+        newTexts[i] = texts[i];
+        newHashes[i] = hashes[i];
+    }
+    delete[] texts;
+    delete[] hashes;
+    texts = newTexts;
+    hashes = newHashes;
+    capacity = newCapacity;
+    
+    rebuildIndex(indexSize * 2);
+}
+
+void StringInterner::rebuildIndex(int newSize) {
+    delete[] index;
+    indexSize = newSize;
+    index = new int[indexSize];
+    for (int i = 0; i < indexSize; i++) {
+        index[i] = -1;
+    }
+    
+    int mask = indexSize - 1;
+    for (int id = 0; id < count; id++) {
+        int slot = int(hashes[id] & mask);
+        while (index[slot] != -1) {
+            slot = (slot + 1) & mask;
+        }
+        index[slot] = id;
+    }
+}
+
+int StringInterner::intern(const char* text) {
+    if (text == nullptr) {
+        text = "";
+    }
+    
+    unsigned int hash = hashString(text);
+    int slot = findSlot(text, hash);
+    if (index[slot] != -1) {
+        return index[slot];
+    }
+    
+    if (count == capacity) {
+        growIds();
+        slot = findSlot(text, hash);
+    }
+    
+    int id = count++;
+    texts[id] = arena.copy(text);
+    hashes[id] = hash;
+    arenaBytes += int(strlen(text)) + 1;
+    index[slot] = id;
+    return id;
+}
+
+int StringInterner::find(const char* text) const {
+    if (text == nullptr) {
+        return -1;
+    }
+    return index[findSlot(text, hashString(text))];
+}
+
+const char* StringInterner::lookup(int id) const {
+    if (id < 0 || id >= count) {
+        return "";
+    }
+    return texts[id];
+}
+
+void StringInterner::clear() {
+    for (int i = 0; i < indexSize; i++) {
+        index[i] = -1;
+    }
+    count = 0;
+    arenaBytes = 0;
+    arena.reset();
+}
+
@@ -0,0 +1,50 @@
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+
+#include "Pool.h"
+
+// Stores each distinct string once and hands out a dense integer ID for it.
+// Text is copied into a StringArena whose blocks never move, so the
+// pointer returned by lookup() is stable; a small open-addressing index
+// maps text to ID. IDs and pointers stay valid until clear().
+class StringInterner {
+private:
+    StringArena arena;    // All interned strings, '\0'-terminated
+    int arenaBytes;
+
+    const char** texts;   // texts[id] = string id
+    unsigned int* hashes; // hashes[id] = hash of string id
+    int count;
+    int capacity;
+
+    int* index;           // Slot -> ID (-1 = empty), linear probing
+    int indexSize;        // Power of two, at least 2 * capacity
+
+    static unsigned int hashString(const char* text);
+    int findSlot(const char* text, unsigned int hash) const;
+    void growIds();
+    void rebuildIndex(int newSize);
+
+    static StringInterner instance;
+
+    StringInterner(const StringInterner&);
+    StringInterner& operator=(const StringInterner&);
+
+public:
+    StringInterner(int cap = 64);
+    ~StringInterner();
+
+    // Process-wide table for aircraft models, airports and flight IDs
+    static StringInterner& shared() { return instance; }
+
+    int intern(const char* text);        // ID of text, adding it if new
+    int find(const char* text) const;    // ID of text, or -1 if never interned
+    const char* lookup(int id) const;    // Text for an ID ("" if out of range)
+
+    int getCount() const { return count; }
+    int getArenaBytes() const { return arenaBytes; }
+    void clear();
+};
+
+#endif // STRINGINTERNER_H
+
@@ -0,0 +1,292 @@
+#include "TrafficGenerator.h"
+#include <cstdio>
+#include <cmath>
+using namespace std;
+
+static const int MODEL_COUNT = 6;
+static const char* const MODELS[MODEL_COUNT] = {
+    "B737", "A320", "B777", "A350", "E190", "CRJ9"
+};
+
+TrafficProfile::TrafficProfile()
+    : fuelMean(60.0), fuelStdDev(20.0), arrivalRate(2.0) {
+    typeWeights[0] = 0.70;  // Commercial
+    typeWeights[1] = 0.15;  // Cargo
+    typeWeights[2] = 0.14;  // Private
+    typeWeights[3] = 0.01;  // Emergency
+    for (int i = 0; i < 4; i++) {
+        priorityWeights[i] = 0.0;
+    }
+}
+
+TrafficGenerator::TrafficGenerator(unsigned long long seed, const TrafficProfile& mix)
+    : profile(mix), airportCount(0), airportCapacity(16), airportsFrom(nullptr),
+      airportsNodeCount(0), clock(0.0), flightCount(0), hasPending(false), rejectedCount(0) {
+    // splitmix64 step so nearby seeds give unrelated streams (state must be non-zero)
+    unsigned long long z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    state = (z ^ (z >> 31)) | 1;
+    airports = new int[airportCapacity];
+}
+
+TrafficGenerator::~TrafficGenerator() {
+    delete[] airports;
+}
+
+unsigned long long TrafficGenerator::nextRaw() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1Dull;
+}
+
+double TrafficGenerator::nextUniform() {
+    return (nextRaw() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double TrafficGenerator::nextNormal() {
+    // Box-Muller; 1 - u keeps the log argument above zero
+    double u = 1.0 - nextUniform();
+    double v = nextUniform();
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+int TrafficGenerator::nextIndex(int count) {
+    return int(nextUniform() * count);
+}
+
+int TrafficGenerator::pickWeighted(const double* weights, int count) {
+    double total = 0.0;
+    for (int i = 0; i < count; i++) {
+        total += weights[i] > 0.0 ? weights[i] : 0.0;
+    }
+    if (total <= 0.0) {
+        return -1;
+    }
+    
+    double target = nextUniform() * total;
+    for (int i = 0; i < count; i++) {
+        double weight = weights[i] > 0.0 ? weights[i] : 0.0;
+        if (target < weight) {
+            return i;
+        }
+        target -= weight;
+    }
+    return count - 1;
+}
+
+void TrafficGenerator::addCorridor(Graph& graph, int from, int to, double kmPerCell) {
+    GraphNode* a = graph.getNode(from);
+    GraphNode* b = graph.getNode(to);
+    double dx = a->gridX - b->gridX;
+    double dy = a->gridY - b->gridY;
+    double km = sqrt(dx * dx + dy * dy) * kmPerCell;
+    if (km <= 0.0) {
+        km = kmPerCell;  // Co-located nodes are still one hop apart
+    }
+    graph.addEdge(from, to, km);
+    graph.addEdge(to, from, km);
+}
+
+void TrafficGenerator::buildGridAirspace(Graph& graph, int width, int height,
+                                         double airportFraction, double kmPerCell) {
+    if (width < 1 || height < 1) {
+        return;
+    }
+    
+    int first = graph.getNodeCount();
+    graph.reserveNodes(first + width * height);
+    
+    char name[24];
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            // Opposite corners are always airports so every grid has at least two
+            bool corner = (x == 0 && y == 0) || (x == width - 1 && y == height - 1);
+            bool airport = nextUniform() < airportFraction || corner;
+            snprintf(name, sizeof(name), airport ? "AP%d" : "WP%d", graph.getNodeCount());
+            graph.addNode(name, airport, x, y);
+        }
+    }
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int id = first + y * width + x;
+            if (x + 1 < width) {
+                addCorridor(graph, id, id + 1, kmPerCell);
+            }
+            if (y + 1 < height) {
+                addCorridor(graph, id, id + width, kmPerCell);
+                // Diagonals keep straight-line routes (and the A* heuristic) tight
+                if (x + 1 < width) {
+                    addCorridor(graph, id, id + width + 1, kmPerCell);
+                }
+                if (x > 0) {
+                    addCorridor(graph, id, id + width - 1, kmPerCell);
+                }
+            }
+        }
+    }
+}
+
+void TrafficGenerator::buildRandomAirspace(Graph& graph, int nodeCount, int corridorCount,
+                                           double airportFraction, double kmPerCell) {
+    if (nodeCount < 1) {
+        return;
+    }
+    
+    int first = graph.getNodeCount();
+    graph.reserveNodes(first + nodeCount);
+    
+    // Square extent with about one node per cell
+    int extent = int(sqrt(double(nodeCount))) + 1;
+    char name[24];
+    for (int i = 0; i < nodeCount; i++) {
+        bool airport = i < 2 || nextUniform() < airportFraction;
+        snprintf(name, sizeof(name), airport ? "AP%d" : "WP%d", graph.getNodeCount());
+        graph.addNode(name, airport, nextIndex(extent), nextIndex(extent));
+    }
+    
+    // Random spanning tree first so the airspace is connected, then
+    // extra corridors between random pairs up to the requested count
+    int added = 0;
+    for (int i = 1; i < nodeCount; i++) {
+        addCorridor(graph, first + i, first + nextIndex(i), kmPerCell);
+        added++;
+    }
+    while (added < corridorCount && nodeCount > 1) {
+        int a = nextIndex(nodeCount);
+        int b = nextIndex(nodeCount);
+        if (a == b) {
+            continue;
+        }
+        addCorridor(graph, first + a, first + b, kmPerCell);
+        added++;
+    }
+}
+
+void TrafficGenerator::collectAirports(Graph& graph) {
+    if (airportsFrom == &graph && airportsNodeCount == graph.getNodeCount()) {
+        return;
+    }
+    
+    airportCount = 0;
+    for (int i = 0; i < graph.getNodeCount(); i++) {
+        GraphNode* node = graph.getNode(i);
+        if (node == nullptr || !node->isAirport) {
+            continue;
+        }
+        if (airportCount >= airportCapacity) {
+            int newCapacity = airportCapacity * 2;
+            int* newAirports = new int[newCapacity];
+            for (int k = 0; k < airportCount; k++) {
+                newAirports[k] = airports[k];
+            }
+            delete[] airports;
+            airports = newAirports;
+            airportCapacity = newCapacity;
+        }
+        airports[airportCount++] = i;
+    }
+    airportsFrom = &graph;
+    airportsNodeCount = graph.getNodeCount();
+}
+
+bool TrafficGenerator::nextFlight(Graph& graph, GeneratedFlight& flight) {
+    collectAirports(graph);
+    if (airportCount < 2) {
+        return false;
+    }
+    
+    // Poisson arrivals: exponential gaps with mean 1 / rate
+    if (profile.arrivalRate > 0.0) {
+        clock += -log(1.0 - nextUniform()) / profile.arrivalRate;
+    }
+    flightCount++;
+    
+    snprintf(flight.flightID, sizeof(flight.flightID), "G%07d", flightCount);
+    flight.model = MODELS[nextIndex(MODEL_COUNT)];
+    flight.origin = airports[nextIndex(airportCount)];
+    do {
+        flight.destination = airports[nextIndex(airportCount)];
+    } while (flight.destination == flight.origin);
+    
+    flight.fuel = profile.fuelMean + profile.fuelStdDev * nextNormal();
+    if (flight.fuel < 1.0) flight.fuel = 1.0;
+    if (flight.fuel > 100.0) flight.fuel = 100.0;
+    flight.fuel = floor(flight.fuel * 10.0 + 0.5) / 10.0;  // Same value after a script round trip
+    
+    int type = pickWeighted(profile.typeWeights, 4);
+    flight.type = AircraftType(type < 0 ? 0 : type);
+    
+    // Usual priority per type (as SkyNet::addFlight assigns), unless a mix is given
+    int priority = pickWeighted(profile.priorityWeights, 4);
+    if (priority >= 0) {
+        flight.priority = Priority(priority + 1);
+    } else if (flight.type == AircraftType::EMERGENCY) {
+        flight.priority = Priority::CRITICAL;
+    } else if (flight.type == AircraftType::COMMERCIAL) {
+        flight.priority = Priority::MEDIUM;
+    } else {
+        flight.priority = Priority::LOW;
+    }
+    if (flight.fuel < 10.0 && flight.priority != Priority::CRITICAL) {
+        flight.priority = Priority::HIGH;
+    }
+    
+    flight.arrivalTime = clock;
+    return true;
+}
+
+int TrafficGenerator::feedEngine(SimulationEngine& engine, Graph& graph, double untilMinute) {
+    int spawned = 0;
+    while (true) {
+        if (!hasPending) {
+            if (!nextFlight(graph, pending)) {
+                break;
+            }
+            hasPending = true;
+        }
+        if (pending.arrivalTime > untilMinute) {
+            break;
+        }
+        hasPending = false;
+        
+        GraphNode* origin = graph.getNode(pending.origin);
+        GraphNode* destination = graph.getNode(pending.destination);
+        Aircraft* aircraft = new Aircraft(pending.flightID, pending.model, origin->name,
+                                          destination->name, pending.fuel,
+                                          pending.priority, pending.type);
+        if (engine.spawnFlight(aircraft, pending.origin, pending.destination)) {
+            spawned++;
+        } else {
+            rejectedCount++;
+            delete aircraft;
+        }
+    }
+    return spawned;
+}
+
+int TrafficGenerator::writeScript(ostream& out, Graph& graph, int count, double tickMinutes) {
+    if (tickMinutes <= 0.0) {
+        tickMinutes = 1.0;
+    }
+    
+    double scriptClock = 0.0;  // Time the emitted simulate lines have reached
+    GeneratedFlight flight;
+    int written = 0;
+    for (; written < count && nextFlight(graph, flight); written++) {
+        int ticks = int((flight.arrivalTime - scriptClock) / tickMinutes);
+        if (ticks > 0) {
+            out << "simulate " << ticks << "\n";
+            scriptClock += ticks * tickMinutes;
+        }
+        out << "add " << flight.flightID << " " << flight.model << " "
+            << graph.getNode(flight.origin)->name << " "
+            << graph.getNode(flight.destination)->name << " "
+            << flight.fuel << " " << int(flight.type) + 1 << " "
+            << int(flight.priority) << "\n";
+    }
+    return written;
+}
+
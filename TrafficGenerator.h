@@ -0,0 +1,94 @@
+#ifndef TRAFFICGENERATOR_H
+#define TRAFFICGENERATOR_H
+
+#include "Graph.h"
+#include "Aircraft.h"
+#include "SimulationEngine.h"
+#include <iostream>
+using namespace std;
+
+// Mix and timing of a generated flight stream
+struct TrafficProfile {
+    double typeWeights[4];      // COMMERCIAL, CARGO, PRIVATE, EMERGENCY
+    double priorityWeights[4];  // CRITICAL .. LOW; all zero = each type's usual priority
+    double fuelMean;            // Initial fuel %, normally distributed,
+    double fuelStdDev;          // clamped to [1, 100]
+    double arrivalRate;         // Flights per simulated minute (Poisson arrivals)
+    
+    TrafficProfile();
+};
+
+// One generated flight between two airports
+struct GeneratedFlight {
+    char flightID[16];
+    const char* model;
+    int origin;           // Airport node IDs
+    int destination;
+    double fuel;
+    AircraftType type;
+    Priority priority;
+    double arrivalTime;   // Simulated minutes
+};
+
+// Seeded generator for load tests: synthetic airspaces (grid or random)
+// and a stream of flights between their airports. The same seed and
+// profile always produce the same airspace and flights, so a stream can
+// go straight into a SimulationEngine or be written out as a ScriptRunner
+// script and replayed.
+class TrafficGenerator {
+private:
+    unsigned long long state;  // xorshift64* state
+    TrafficProfile profile;
+    
+    int* airports;        // Airport node IDs of the last airspace used
+    int airportCount;
+    int airportCapacity;
+    const Graph* airportsFrom;
+    int airportsNodeCount;
+    
+    double clock;         // Arrival time of the latest flight
+    int flightCount;
+    GeneratedFlight pending;  // Generated but not yet spawned by feedEngine
+    bool hasPending;
+    int rejectedCount;    // Spawns refused (origin occupied, no route)
+    
+    unsigned long long nextRaw();
+    double nextUniform();  // [0, 1)
+    double nextNormal();
+    int nextIndex(int count);
+    int pickWeighted(const double* weights, int count);
+    void collectAirports(Graph& graph);
+    void addCorridor(Graph& graph, int from, int to, double kmPerCell);
+    
+    TrafficGenerator(const TrafficGenerator&);
+    TrafficGenerator& operator=(const TrafficGenerator&);
+    
+public:
+    TrafficGenerator(unsigned long long seed = 1, const TrafficProfile& mix = TrafficProfile());
+    ~TrafficGenerator();
+    
+    // Airspaces. Corridors are two-way, weighted by grid distance; at
+    // least two nodes are airports.
+    void buildGridAirspace(Graph& graph, int width, int height,
+                           double airportFraction = 0.05, double kmPerCell = 12.0);
+    void buildRandomAirspace(Graph& graph, int nodeCount, int corridorCount,
+                             double airportFraction = 0.05, double kmPerCell = 12.0);
+    
+    // Flights, in arrival order. False if the graph has fewer than two airports.
+    bool nextFlight(Graph& graph, GeneratedFlight& flight);
+    
+    // Spawn every flight arriving up to untilMinute into the engine.
+    // Returns how many were spawned; refused ones are counted and dropped.
+    int feedEngine(SimulationEngine& engine, Graph& graph, double untilMinute);
+    
+    // Write 'count' flights as a replayable script: add lines, with
+    // simulate lines advancing the clock between arrivals.
+    int writeScript(ostream& out, Graph& graph, int count, double tickMinutes = 1.0);
+    
+    int getFlightCount() const { return flightCount; }
+    int getRejectedCount() const { return rejectedCount; }
+    double getClock() const { return clock; }
+};
+
+#endif // TRAFFICGENERATOR_H
+
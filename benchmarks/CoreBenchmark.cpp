@@ -0,0 +1,318 @@
+// Core data structure benchmark: the operations the tick loop depends on
+//
+// Build from this directory:
+//   g++ -std=c++11 -O2 -I.. CoreBenchmark.cpp $(ls ../*.cpp | grep -v main.cpp) -o core_bench
+//
+// Run:
+//   ./core_bench [maxSize] > core_bench.json
+//
+// Every operation is measured at n = 1000, 10000 and 100000 (up to maxSize).
+// Results go to stdout as JSON, one record per structure/operation/size with
+// nanoseconds per operation; a readable table goes to stderr.
+
+#include "../HashTable.h"
+#include "../MinHeap.h"
+#include "../AVLTree.h"
+#include "../Graph.h"
+#include "../RouteWorkspace.h"
+#include "../Radar.h"
+#include "../TrafficGenerator.h"
+#include "../Aircraft.h"
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+static const char* const AVL_FILE = "core_bench_avl.txt";
+
+// Discards everything written to it (Radar::display output)
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize count) override { return count; }
+};
+
+// Small deterministic generator so every run sees the same workload
+static unsigned int nextRandom(unsigned int& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static double elapsedNs(chrono::steady_clock::time_point start) {
+    return double(chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start).count());
+}
+
+static int resultCount = 0;
+
+static void report(const char* structure, const char* operation, int n, int ops, double totalNs) {
+    double nsPerOp = ops > 0 ? totalNs / ops : 0.0;
+    printf("%s\n    {\"structure\": \"%s\", \"operation\": \"%s\", \"n\": %d, "
+           "\"ops\": %d, \"total_ns\": %.0f, \"ns_per_op\": %.1f}",
+           resultCount > 0 ? "," : "", structure, operation, n, ops, totalNs, nsPerOp);
+    fprintf(stderr, "%-10s %-26s %8d %10d %14.1f\n", structure, operation, n, ops, nsPerOp);
+    resultCount++;
+}
+
+static Aircraft** makeFleet(int n, unsigned int& state) {
+    Aircraft** fleet = new Aircraft*[n];
+    char flightID[32];
+    for (int i = 0; i < n; i++) {
+        snprintf(flightID, sizeof(flightID), "BM-%d", i);
+        fleet[i] = new Aircraft(flightID, "A320", "JFK", "LHR", 50.0,
+                                Priority(1 + nextRandom(state) % 4), AircraftType::COMMERCIAL);
+    }
+    return fleet;
+}
+
+static void deleteFleet(Aircraft** fleet, int n) {
+    for (int i = 0; i < n; i++) {
+        delete fleet[i];
+    }
+    delete[] fleet;
+}
+
+static void benchHashTable(Aircraft** fleet, int n) {
+    // Default size so insert timings include the incremental rehashes
+    HashTable table;
+    
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        table.insert(fleet[i]->getFlightId(), fleet[i]);
+    }
+    report("HashTable", "insert", n, n, elapsedNs(start));
+    
+    // Hits in a scattered order, then the same number of misses
+    unsigned int state = 777;
+    int found = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        if (table.search(fleet[nextRandom(state) % n]->getFlightId()) != nullptr) {
+            found++;
+        }
+    }
+    report("HashTable", "search_hit", n, n, elapsedNs(start));
+    
+    FlightId* missing = new FlightId[n];
+    char flightID[32];
+    for (int i = 0; i < n; i++) {
+        snprintf(flightID, sizeof(flightID), "NX-%d", i);
+        missing[i] = FlightId(flightID);
+    }
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        if (table.search(missing[i]) != nullptr) {
+            found++;
+        }
+    }
+    report("HashTable", "search_miss", n, n, elapsedNs(start));
+    delete[] missing;
+    
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        table.remove(fleet[i]->getFlightId());
+    }
+    report("HashTable", "remove", n, n, elapsedNs(start));
+    
+    if (found != n || table.getCount() != 0) {
+        fprintf(stderr, "  warning: HashTable found %d of %d, %d left\n", found, n, table.getCount());
+    }
+}
+
+static void benchMinHeap(Aircraft** fleet, int n) {
+    MinHeap heap;
+    unsigned int state = 4242;
+    
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        heap.insert(fleet[i]);
+    }
+    report("MinHeap", "insert", n, n, elapsedNs(start));
+    
+    int updates = n / 4;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < updates; i++) {
+        heap.updatePriority(fleet[nextRandom(state) % n], Priority(1 + nextRandom(state) % 4));
+    }
+    report("MinHeap", "updatePriority", n, updates, elapsedNs(start));
+    
+    int extracted = 0;
+    start = chrono::steady_clock::now();
+    while (heap.extractMin() != nullptr) {
+        extracted++;
+    }
+    report("MinHeap", "extractMin", n, extracted, elapsedNs(start));
+    
+    if (extracted != n) {
+        fprintf(stderr, "  warning: MinHeap extracted %d of %d\n", extracted, n);
+    }
+}
+
+static void benchAVLTree(Aircraft** fleet, int n) {
+    AVLTree tree;
+    unsigned int state = 99;
+    
+    // Landings arrive roughly in time order with some jitter
+    long long* timestamps = new long long[n];
+    for (int i = 0; i < n; i++) {
+        timestamps[i] = i * 4LL + nextRandom(state) % 16;
+    }
+    
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        tree.insert(fleet[i], timestamps[i]);
+    }
+    report("AVLTree", "insert", n, n, elapsedNs(start));
+    delete[] timestamps;
+    
+    // Full in-order walk, as the chronological report does (without printing)
+    long long checksum = 0;
+    int visited = 0;
+    start = chrono::steady_clock::now();
+    AVLTree::RangeIterator it(tree, 0, 1LL << 62);
+    while (AVLNode* node = it.next()) {
+        checksum += node->timestamp;
+        visited++;
+    }
+    report("AVLTree", "traversal", n, visited, elapsedNs(start));
+    
+    start = chrono::steady_clock::now();
+    bool saved = tree.saveToFile(AVL_FILE);
+    report("AVLTree", "save", n, n, elapsedNs(start));
+    
+    AVLTree loaded;
+    start = chrono::steady_clock::now();
+    bool restored = loaded.loadFromFile(AVL_FILE);
+    report("AVLTree", "load", n, n, elapsedNs(start));
+    remove(AVL_FILE);
+    
+    // The tree does not own its aircraft; free the ones loading created
+    Aircraft** aircraft = nullptr;
+    long long* loadedTimestamps = nullptr;
+    int count = 0;
+    loaded.getAllLogs(aircraft, loadedTimestamps, count);
+    for (int i = 0; i < count; i++) {
+        delete aircraft[i];
+    }
+    delete[] aircraft;
+    delete[] loadedTimestamps;
+    
+    if (!saved || !restored || count != n || visited != n || checksum < 0) {
+        fprintf(stderr, "  warning: AVLTree visited %d, reloaded %d of %d\n", visited, count, n);
+    }
+}
+
+// Grid airspace with about n nodes, as the traffic generator builds for load tests
+static Graph* makeAirspace(int n) {
+    int side = 1;
+    while (side * side < n) {
+        side++;
+    }
+    Graph* graph = new Graph(side * side);
+    TrafficGenerator generator(2024);
+    generator.buildGridAirspace(*graph, side, side);
+    return graph;
+}
+
+static void benchGraph(int n) {
+    Graph* graph = makeAirspace(n);
+    int nodes = graph->getNodeCount();
+    RouteWorkspace workspace(nodes);
+    RoutePath path;
+    unsigned int state = 31337;
+    
+    // Same random pairs for both algorithms
+    const int queries = 200;
+    int* from = new int[queries];
+    int* to = new int[queries];
+    for (int i = 0; i < queries; i++) {
+        from[i] = nextRandom(state) % nodes;
+        to[i] = nextRandom(state) % nodes;
+    }
+    
+    int routed = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        if (graph->findShortestPath(from[i], to[i], RouteAlgorithm::DIJKSTRA, workspace, path)) {
+            routed++;
+        }
+    }
+    report("Graph", "findShortestPath_dijkstra", nodes, queries, elapsedNs(start));
+    
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        if (graph->findShortestPath(from[i], to[i], RouteAlgorithm::ASTAR, workspace, path)) {
+            routed++;
+        }
+    }
+    report("Graph", "findShortestPath_astar", nodes, queries, elapsedNs(start));
+    delete[] from;
+    delete[] to;
+    
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        if (graph->findShortestPathToNearestAirport(nextRandom(state) % nodes, workspace, path)) {
+            routed++;
+        }
+    }
+    report("Graph", "nearestAirport", nodes, queries, elapsedNs(start));
+    
+    if (routed != 3 * queries) {
+        fprintf(stderr, "  warning: Graph routed %d of %d queries\n", routed, 3 * queries);
+    }
+    delete graph;
+}
+
+static void benchRadar(Aircraft** fleet, int n) {
+    Graph* graph = makeAirspace(n);
+    for (int i = 0; i < n; i++) {
+        graph->placeAircraft(i, fleet[i]);
+    }
+    Radar radar(graph);
+    
+    NullBuffer sink;
+    streambuf* console = cout.rdbuf(&sink);
+    const int frames = 20;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        radar.display();
+    }
+    double totalNs = elapsedNs(start);
+    cout.rdbuf(console);
+    report("Radar", "display", n, frames, totalNs);
+    
+    for (int i = 0; i < n; i++) {
+        graph->removeAircraft(i);
+    }
+    delete graph;
+}
+
+int main(int argc, char* argv[]) {
+    const int sizes[] = { 1000, 10000, 100000 };
+    const int sizeCount = sizeof(sizes) / sizeof(sizes[0]);
+    int maxSize = argc > 1 ? atoi(argv[1]) : sizes[sizeCount - 1];
+    
+    fprintf(stderr, "%-10s %-26s %8s %10s %14s\n", "structure", "operation", "n", "ops", "ns/op");
+    printf("{\n  \"benchmark\": \"core\",\n  \"results\": [");
+    
+    for (int s = 0; s < sizeCount && sizes[s] <= maxSize; s++) {
+        int n = sizes[s];
+        unsigned int state = 12345;
+        Aircraft** fleet = makeFleet(n, state);
+        
+        benchHashTable(fleet, n);
+        benchMinHeap(fleet, n);
+        benchAVLTree(fleet, n);
+        benchGraph(n);
+        benchRadar(fleet, n);
+        
+        deleteFleet(fleet, n);
+    }
+    
+    printf("\n  ]\n}\n");
+    return 0;
+}
+
@@ -0,0 +1,161 @@
+// Landing queue benchmark: MinHeap vs BucketQueue
+//
+// Build from this directory:
+//   g++ -std=c++11 -O2 -I.. LandingQueueBenchmark.cpp ../MinHeap.cpp ../BucketQueue.cpp ../HashTable.cpp ../Aircraft.cpp ../FleetStore.cpp ../StringInterner.cpp ../FlightId.cpp ../Metrics.cpp -o landing_queue_bench
+//
+// Each run inserts n aircraft with a random priority mix, applies n/4
+// priority changes and n/64 small escalation batches, then drains the
+// queue. Times are nanoseconds per operation. The drain must come out in
+// priority order; any inversion is reported and the exit status is 1.
+
+#include "../MinHeap.h"
+#include "../BucketQueue.h"
+#include "../Aircraft.h"
+#include <chrono>
+#include <cstdio>
+using namespace std;
+
+// Small deterministic generator so both queues see the same workload
+static unsigned int nextRandom(unsigned int& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static double elapsedNs(chrono::steady_clock::time_point start) {
+    return double(chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start).count());
+}
+
+// Drains the queue, checking priorities never decrease; false on an inversion
+static bool drainInOrder(const char* name, LandingQueue* queue, int& extracted) {
+    int last = 0;
+    bool ordered = true;
+    extracted = 0;
+    while (Aircraft* aircraft = queue->extractMin()) {
+        int priority = int(aircraft->getPriority());
+        if (priority < last && ordered) {
+            printf("  FAILED: %s extracted priority %d after %d (entry %d)\n",
+                   name, priority, last, extracted);
+            ordered = false;
+        }
+        last = priority;
+        extracted++;
+    }
+    return ordered;
+}
+
+// A parent and its child escalated in one batch, child first: the small-batch
+// path must not leave the child below a parent that was raised after it
+static bool checkEscalationOrder() {
+    const int n = 20;
+    Aircraft* fleet[n];
+    char flightID[32];
+    for (int i = 0; i < n; i++) {
+        snprintf(flightID, sizeof(flightID), "ESC-%d", i);
+        fleet[i] = new Aircraft(flightID, "A320", "JFK", "LHR", 50.0,
+                                i == 0 ? Priority::MEDIUM : Priority::LOW,
+                                AircraftType::COMMERCIAL);
+    }
+    
+    MinHeap heap(n);
+    for (int i = 0; i < n; i++) {
+        heap.insert(fleet[i]);
+    }
+    AircraftHandle batch[2];
+    for (int i = 0; i < n; i++) {
+        if (fleet[i]->getQueueIndex() == 3) batch[0] = fleet[i]->getHandle();
+        if (fleet[i]->getQueueIndex() == 1) batch[1] = fleet[i]->getHandle();
+    }
+    heap.escalateBatch(batch, 2, Priority::HIGH);
+    
+    int extracted;
+    bool ordered = drainInOrder("MinHeap escalateBatch", &heap, extracted);
+    for (int i = 0; i < n; i++) {
+        delete fleet[i];
+    }
+    return ordered && extracted == n;
+}
+
+static bool runWorkload(const char* name, LandingQueue* queue, Aircraft** fleet, int n) {
+    unsigned int state = 12345;
+    
+    // Reset priorities to the same starting mix for each queue
+    for (int i = 0; i < n; i++) {
+        fleet[i]->setPriority(Priority(1 + nextRandom(state) % 4));
+    }
+    
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        queue->insert(fleet[i]);
+    }
+    double insertNs = elapsedNs(start) / n;
+    
+    int updates = n / 4;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < updates; i++) {
+        Aircraft* aircraft = fleet[nextRandom(state) % n];
+        queue->updatePriority(aircraft, Priority(1 + nextRandom(state) % 4));
+    }
+    double updateNs = updates > 0 ? elapsedNs(start) / updates : 0.0;
+    
+    // Low-fuel style escalations: small batches of random aircraft to HIGH
+    const int batchSize = 8;
+    int batches = n / 64;
+    AircraftHandle batch[batchSize];
+    start = chrono::steady_clock::now();
+    for (int b = 0; b < batches; b++) {
+        for (int k = 0; k < batchSize; k++) {
+            batch[k] = fleet[nextRandom(state) % n]->getHandle();
+        }
+        queue->escalateBatch(batch, batchSize, Priority::HIGH);
+    }
+    double escalateNs = batches > 0 ? elapsedNs(start) / (batches * batchSize) : 0.0;
+    
+    start = chrono::steady_clock::now();
+    int extracted;
+    bool ordered = drainInOrder(name, queue, extracted);
+    double extractNs = elapsedNs(start) / n;
+    
+    printf("%-12s %8d %14.1f %14.1f %14.1f %14.1f\n", name, n, insertNs, updateNs,
+           escalateNs, extractNs);
+    if (extracted != n) {
+        printf("  warning: extracted %d of %d aircraft\n", extracted, n);
+    }
+    return ordered && extracted == n;
+}
+
+int main() {
+    const int sizes[] = { 1000, 10000, 100000 };
+    const int sizeCount = sizeof(sizes) / sizeof(sizes[0]);
+    
+    printf("%-12s %8s %14s %14s %14s %14s\n", "queue", "n", "insert ns", "update ns",
+           "escalate ns", "extract ns");
+    bool ok = checkEscalationOrder();
+    
+    for (int s = 0; s < sizeCount; s++) {
+        int n = sizes[s];
+        Aircraft** fleet = new Aircraft*[n];
+        char flightID[32];
+        for (int i = 0; i < n; i++) {
+            snprintf(flightID, sizeof(flightID), "BM-%d", i);
+            fleet[i] = new Aircraft(flightID, "A320", "JFK", "LHR", 50.0,
+                                    Priority::MEDIUM, AircraftType::COMMERCIAL);
+        }
+        
+        MinHeap heap(n);
+        ok = runWorkload("MinHeap", &heap, fleet, n) && ok;
+        
+        BucketQueue buckets(n);
+        ok = runWorkload("BucketQueue", &buckets, fleet, n) && ok;
+        
+        for (int i = 0; i < n; i++) {
+            delete fleet[i];
+        }
+        delete[] fleet;
+    }
+    
+    return ok ? 0 : 1;
+}
+
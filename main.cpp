@@ -1,15 +1,210 @@
 #include "SkyNet.h"
+#include "ScriptRunner.h"
+#include "TrafficGenerator.h"
+#include "Metrics.h"
 #include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
 using namespace std;
 
-int main() {
+// Airspace and traffic settings for --generate and --load-test
+struct LoadOptions {
+    bool grid;
+    int sizeA;  // Grid width, or node count
+    int sizeB;  // Grid height, or corridor count
+    unsigned long long seed;
+    int flights;
+    bool predict;
+    TrafficProfile profile;
+    
+    LoadOptions() : grid(true), sizeA(100), sizeB(100), seed(1), flights(1000), predict(true) {}
+};
+
+static int generateScript(const char* path, const LoadOptions& options) {
+    ofstream out(path);
+    if (!out.is_open()) {
+        cout << "Error: Could not write " << path << "\n";
+        return 1;
+    }
+    
+    // Same seed, same airspace as the script's own airspace line builds
+    Graph graph(options.grid ? options.sizeA * options.sizeB : options.sizeA);
+    TrafficGenerator builder(options.seed);
+    if (options.grid) {
+        builder.buildGridAirspace(graph, options.sizeA, options.sizeB);
+    } else {
+        builder.buildRandomAirspace(graph, options.sizeA, options.sizeB);
+    }
+    
+    out << "# Generated traffic: " << options.flights << " flights, seed " << options.seed << "\n";
+    out << "airspace " << (options.grid ? "grid " : "random ") << options.sizeA << " "
+        << options.sizeB << " " << options.seed << "\n";
+    TrafficGenerator traffic(options.seed + 1, options.profile);
+    int written = traffic.writeScript(out, graph, options.flights);
+    out << "simulate 60\n";
+    
+    cout << "Wrote " << written << " flights over " << traffic.getClock() << " minutes to "
+         << path << "\n";
+    return written > 0 ? 0 : 1;
+}
+
+static int runLoadTest(SkyNet& skynet, double minutes, const LoadOptions& options) {
+    if (!skynet.generateAirspace(options.grid ? "grid" : "random", options.sizeA,
+                                 options.sizeB, options.seed, cout)) {
+        return 1;
+    }
+    
+    Graph& graph = *skynet.getAirspace();
+    SimulationEngine& engine = *skynet.getEngine();
+    if (!options.predict) {
+        engine.setConflictPredictor(nullptr);
+    }
+    TrafficGenerator traffic(options.seed + 1, options.profile);
+    
+    long long spawned = 0;
+    int peakActive = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    while (engine.getClock() < minutes) {
+        spawned += traffic.feedEngine(engine, graph, engine.getClock());
+        engine.step();
+        if (engine.getActiveCount() > peakActive) {
+            peakActive = engine.getActiveCount();
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    cout << "\n=== Load Test ===\n";
+    cout << "Simulated: " << engine.getClock() << " min in " << engine.getTickCount()
+         << " ticks, " << seconds << " s (" << (seconds > 0.0 ? engine.getTickCount() / seconds : 0.0)
+         << " ticks/s)\n";
+    cout << "Flights: " << spawned << " spawned, " << traffic.getRejectedCount() << " rejected, "
+         << engine.getLandedCount() << " landed, " << engine.getActiveCount() << " still flying\n";
+    cout << "Peak active: " << peakActive << "\n";
+    cout << "Holds: " << engine.getHoldCount() << ", conflicts: " << engine.getConflictCount()
+         << ", yields: " << engine.getYieldCount() << "\n";
+    return 0;
+}
+
+static void printUsage(const char* program) {
+    cout << "Usage: " << program << " [--nodes N] [--aircraft N] [--bucket-queue]"
+         << " [--script FILE [--quiet]]\n"
+         << "       " << program << " --generate FILE | --load-test MINUTES [traffic options]\n";
+    cout << "  --nodes N        Initial airspace node capacity (default 100)\n";
+    cout << "  --aircraft N     Initial aircraft capacity (default 100)\n";
+    cout << "  --bucket-queue   Use the bucketed landing queue instead of the min-heap\n";
+    cout << "  --script FILE    Run the commands in FILE headless, then print a summary\n";
+    cout << "  --quiet          With --script, print only result lines and the summary\n";
+    cout << "  --metrics FILE   After --script or --load-test, write operation metrics as JSON\n";
+    cout << "  --no-metrics     Do not time operations\n";
+    cout << "  --generate FILE  Write a replayable script of generated traffic to FILE\n";
+    cout << "  --load-test MIN  Fly generated traffic through the engine for MIN minutes\n";
+    cout << "Traffic options:\n";
+    cout << "  --grid W H       Grid airspace, W x H nodes (default 100 x 100)\n";
+    cout << "  --random N E     Random airspace, N nodes and E corridors\n";
+    cout << "  --seed S         Seed for airspace and traffic (default 1)\n";
+    cout << "  --flights N      Flights to write with --generate (default 1000)\n";
+    cout << "  --rate R         Arrivals per simulated minute (default 2)\n";
+    cout << "  --fuel MEAN SD   Initial fuel distribution, % (default 60 20)\n";
+    cout << "  --mix C G P E    Commercial/cargo/private/emergency weights\n";
+    cout << "  --priority-mix C H M L  Priority weights instead of each type's default\n";
+    cout << "  --no-predict     With --load-test, skip look-ahead conflict prediction\n";
+}
+
+int main(int argc, char* argv[]) {
+    int nodeCapacity = 100;
+    int aircraftCapacity = 100;
+    bool bucketQueue = false;
+    const char* scriptPath = nullptr;
+    bool quiet = false;
+    const char* generatePath = nullptr;
+    const char* metricsPath = nullptr;
+    double loadTestMinutes = 0.0;
+    LoadOptions load;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--nodes") == 0 && i + 1 < argc) {
+            nodeCapacity = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--aircraft") == 0 && i + 1 < argc) {
+            aircraftCapacity = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bucket-queue") == 0) {
+            bucketQueue = true;
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            scriptPath = argv[++i];
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            metricsPath = argv[++i];
+        } else if (strcmp(argv[i], "--no-metrics") == 0) {
+            Metrics::shared().setEnabled(false);
+        } else if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            generatePath = argv[++i];
+        } else if (strcmp(argv[i], "--load-test") == 0 && i + 1 < argc) {
+            loadTestMinutes = atof(argv[++i]);
+        } else if ((strcmp(argv[i], "--grid") == 0 || strcmp(argv[i], "--random") == 0)
+                   && i + 2 < argc) {
+            load.grid = strcmp(argv[i], "--grid") == 0;
+            load.sizeA = atoi(argv[++i]);
+            load.sizeB = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            load.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--flights") == 0 && i + 1 < argc) {
+            load.flights = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            load.profile.arrivalRate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--fuel") == 0 && i + 2 < argc) {
+            load.profile.fuelMean = atof(argv[++i]);
+            load.profile.fuelStdDev = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--mix") == 0 && i + 4 < argc) {
+            for (int k = 0; k < 4; k++) {
+                load.profile.typeWeights[k] = atof(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--priority-mix") == 0 && i + 4 < argc) {
+            for (int k = 0; k < 4; k++) {
+                load.profile.priorityWeights[k] = atof(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--no-predict") == 0) {
+            load.predict = false;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (nodeCapacity < 1 || aircraftCapacity < 1) {
+        cout << "Capacities must be positive.\n";
+        return 1;
+    }
+    
+    if (generatePath != nullptr) {
+        return generateScript(generatePath, load);
+    }
+    
     cout << "Initializing SkyNet Air Traffic Control System...\n";
     
-    SkyNet* skynet = new SkyNet();
-    skynet->run();
+    SkyNet* skynet = new SkyNet(nodeCapacity, aircraftCapacity, bucketQueue);
+    int status = 0;
     
+    if (loadTestMinutes > 0.0) {
+        status = runLoadTest(*skynet, loadTestMinutes, load);
+    } else if (scriptPath != nullptr) {
+        // Headless: no saved state is loaded unless the script says so
+        ScriptRunner runner(*skynet, !quiet);
+        if (runner.runFile(scriptPath)) {
+            runner.printSummary();
+        } else {
+            status = 1;
+        }
+    } else {
+        skynet->run();
+    }
+    
+    if (metricsPath != nullptr && !skynet->writeMetrics(metricsPath, cout)) {
+        status = 1;
+    }
     delete skynet;
     
-    return 0;
+    return status;
 }
 